@@ -32,11 +32,14 @@
 //***********************************************************************************
 // function prototypes
 //***********************************************************************************
-void si7021_i2c_open(I2C_TypeDef *i2c, bool enable);
-void si7021_read(uint32_t command, uint32_t cb, uint32_t byte_count);
+void si7021_i2c_open(I2C_TypeDef *i2c, bool enable, uint32_t tick_cb);
+bool si7021_read(uint32_t command, uint32_t cb, uint32_t cb_payload, uint32_t byte_count);
 float si7021_calculate_humidity();
 float si7021_calculate_temperature();
+int32_t si7021_calculate_humidity_centi(void);
+int32_t si7021_calculate_temperature_deci_f(void);
 bool si7021_i2c_test(uint32_t cb);
-void si7021_write(uint32_t user_register, uint32_t *payload, uint32_t cb);
+bool si7021_write(uint32_t user_register, uint32_t *payload, uint32_t cb);
+I2C_Status si7021_get_status(void);
 
 #endif
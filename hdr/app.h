@@ -24,6 +24,7 @@
 // function prototypes
 //***********************************************************************************
 void app_peripheral_setup(void);
-void run_scheduled_events(uint32_t scheduled_events);
+void run_scheduled_events(void);
+void app_idle(void);
 
 #endif
@@ -4,19 +4,20 @@
 //***********************************************************************************
 // Include files
 //***********************************************************************************
-#include "letimer.h"
 #include "adc.h"
+#include "swtimer.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
 #define	BATTERY_ADC					ADC0
-#define	BATTERY_LETIMER				LETIMER0
-#define BATTERY_POLLING_PERIOD		5
+#define BATTERY_POLLING_PERIOD		5u			// Seconds
 #define BATTERY_LOW_THRESH			4095 * (3.2 / 5.0)
 #define BATTERY_LOW_COUNT_THRESH	5
 #define BATTERY_MAX_V				4.2
 #define BATTERY_MIN_V				3.0
+#define BATTERY_ADC_REF_V			5.0
+#define BATTERY_ADC_FULL_SCALE		4095
 
 //***********************************************************************************
 // global variables
@@ -25,8 +26,10 @@
 //***********************************************************************************
 // function prototypes
 //***********************************************************************************
-void battery_open(void);
+void battery_open(uint32_t poll_cb);
+void battery_start(void);
+void battery_poll(void);
 bool battery_check_low();
-float battery_get_percent();
+uint32_t battery_get_percent_centi(void);
 
 #endif
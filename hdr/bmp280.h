@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 /* The developer's include statements */
+#include "i2c.h"
 
 //***********************************************************************************
 // defined files
@@ -38,6 +39,7 @@
 #define BMP280_TEMP_MSB_REG		0xFA
 #define BMP280_TEMP_LSB_REG		0xFB
 #define BMP280_TEMP_XLSB_REG	0xFC
+#define BMP280_DATA_LEN			6		// Bytes from BMP280_PRESSURE_MSB_REG to BMP280_TEMP_XLSB_REG
 
 #define BMP280_T1	0x88
 #define BMP280_T2	0x8A
@@ -51,21 +53,28 @@
 #define BMP280_P7	0x9A
 #define BMP280_P8	0x9C
 #define BMP280_P9	0x9E
+#define BMP280_CALIB_LEN	24		// Bytes from BMP280_T1 to the end of BMP280_P9
 
 #define SEA_LEVEL_PRESSURE	1013.25
 
 //***********************************************************************************
 // global variables
 //***********************************************************************************
+typedef struct {
+	int32_t temp_centi_c;				// Hundredths of a degree Celsius
+	uint32_t pressure_pa;
+	int32_t altitude_dm;				// Tenths of a meter
+} BMP280_Sample_TypeDef;
 
 
 //***********************************************************************************
 // function prototypes
 //***********************************************************************************
 bool bmp280_i2c_test(uint32_t cb);
-void bmp280_open(uint32_t temp_callback, uint32_t pressure_callback);
-void bmp280_read_temp(void);
-void bmp280_read_pressure(void);
+void bmp280_open(uint32_t callback, uint32_t cb_payload);
+bool bmp280_read(void);
+I2C_Status bmp280_get_status(void);
+void bmp280_get_sample(BMP280_Sample_TypeDef *out);
 
 float bmp280_get_last_temp_read();
 float bmp280_get_last_pressure_read();
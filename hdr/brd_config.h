@@ -22,10 +22,6 @@
 // System Clock setup
 #define MCU_HFRCO_FREQ				cmuHFRCOFreq_38M0Hz
 
-// LETIMER PWM Configuration
-#define     PWM_ROUTE_0				LETIMER_ROUTELOC0_OUT0LOC_LOC0
-#define     PWM_ROUTE_1				LETIMER_ROUTELOC0_OUT1LOC_LOC0
-
 // TIMER Configuration
 
 
@@ -68,6 +64,24 @@
 
 #define		WS2812B_NUM_LEDS			12u
 
+// MX25 SPI flash config; shares USART2 and the MOSI pin (PK0) with the WS2812B
+#define		MX25_USART					USART2
+#define		MX25_RX_ROUTE				USART_ROUTELOC0_RXLOC_LOC30
+#define		MX25_CLK_ROUTE				USART_ROUTELOC0_CLKLOC_LOC18
+
+#define		MX25_MISO_PORT				gpioPortK
+#define		MX25_MISO_PIN				2u
+#define		MX25_MISO_DEFAULT			false
+#define		MX25_MISO_GPIOMODE			gpioModeInput
+#define		MX25_CLK_PORT				gpioPortF
+#define		MX25_CLK_PIN				7u
+#define		MX25_CLK_DEFAULT			false
+#define		MX25_CLK_GPIOMODE			gpioModePushPull
+#define		MX25_CS_PORT				gpioPortK
+#define		MX25_CS_PIN					1u
+#define		MX25_CS_DEFAULT				true		// Deselected
+#define		MX25_CS_GPIOMODE			gpioModePushPull
+
 // Button config
 #define		BUTTON_DEFAULT				true
 
@@ -0,0 +1,28 @@
+#ifndef COLOR_HG
+#define COLOR_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "ws2812b.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		HUE_FRACTION_BITS		8u		// Gradient hues are 8.8 fixed point
+#define		HUE_FULL_TURN			(256u << HUE_FRACTION_BITS)
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void hsv_to_grb(uint8_t hue, uint8_t saturation, uint8_t value, GRB_TypeDef *ret);
+void hsv_gradient(GRB_TypeDef *ret, uint32_t count, uint16_t hue_start, uint16_t hue_step, uint8_t saturation, uint8_t value);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CYCLES_HG
+#define CYCLES_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Core clock cycle counter from the DWT unit, for measuring the cost of code on
+ *	the target. The counter wraps every ~113 s at 38 MHz; unsigned subtraction of
+ *	two readings is correct across a single wrap.
+ */
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+// Starts the DWT cycle counter; safe to call more than once
+static inline void cycles_open(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycles_now(void) {
+	return DWT->CYCCNT;
+}
+
+#endif
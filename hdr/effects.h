@@ -0,0 +1,42 @@
+#ifndef EFFECTS_HG
+#define EFFECTS_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "pov.h"
+#include "textcell.h"
+#include "ws2812b.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		EFFECTS_MAX_COLUMNS			(DISPLAY_NUM_PIXELS_WIDE)
+#define		EFFECTS_MASK_ALL			0x0FFFu	// All WS2812B_NUM_LEDS lit
+
+/*
+ *	Effects render into an array of LED columns, num_columns long, with the same
+ *	layout as a POV_Frame_TypeDef. The column array must be 4-byte aligned.
+ *
+ *	Where an effect takes a mask, bit n of mask[column] enables LED n of that
+ *	column; unlit LEDs are written black. Passing NULL lights every LED.
+ */
+typedef GRB_TypeDef EFFECTS_Column_TypeDef[WS2812B_NUM_LEDS];
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void effects_text_mask(uint16_t *mask, uint32_t num_columns, const TextCell_TypeDef *top, const TextCell_TypeDef *bottom);
+void effects_gradient(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint16_t hue_start, uint16_t hue_step, uint8_t value);
+void effects_color_cycle(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint16_t hue_start, uint16_t hue_step, uint8_t value);
+void effects_plasma(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint32_t phase, uint8_t value);
+void effects_fire(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint8_t value);
+
+#endif
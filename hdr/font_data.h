@@ -0,0 +1,20 @@
+#ifndef FONT_DATA_HG
+#define FONT_DATA_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stddef.h>
+
+#include "fontengine.h"
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+/*
+ *	Fonts generated by tools/fontgen.py, one src/font_<name>.c each.
+ */
+extern const Font_TypeDef font_small;		// 6 rows, proportional version of font.h
+extern const Font_TypeDef font_large;		// 12 rows, fills the full LED column
+
+#endif
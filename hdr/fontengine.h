@@ -0,0 +1,66 @@
+#ifndef FONTENGINE_HG
+#define FONTENGINE_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		FONT_FIRST_CHAR				0x20	// ' '
+#define		FONT_LAST_CHAR				0x7E	// '~'
+#define		FONT_NUM_CHARS				(FONT_LAST_CHAR - FONT_FIRST_CHAR + 1)
+#define		FONT_MAX_HEIGHT				16u
+
+/*
+ *	Proportional fonts, generated from the sources in fonts/ by tools/fontgen.py.
+ *	Each glyph is a run of columns, one uint16_t per column with bit n lighting
+ *	row n from the bottom, so a glyph column shifts straight onto an LED column.
+ */
+typedef struct {
+	uint8_t left;
+	uint8_t right;
+	int8_t adjust;						// Added to spacing; spacing + adjust >= 0
+} Font_Kern_TypeDef;
+
+typedef struct {
+	uint8_t height;
+	uint8_t spacing;					// Blank columns between glyphs
+	char fallback;						// Drawn for characters the font lacks
+	const uint8_t *widths;				// FONT_NUM_CHARS entries
+	const uint16_t *offsets;			// Index of each glyph's first column
+	const uint16_t *columns;
+	const Font_Kern_TypeDef *kerning;	// Sorted by left, then right
+	uint16_t num_kerning;
+} Font_TypeDef;
+
+// Walks a string one display column at a time, spacing and kerning included
+typedef struct {
+	const Font_TypeDef *font;
+	const char *text;
+	uint32_t glyph_column;				// Next column within the current glyph
+	uint32_t gap;						// Blank columns left before the next glyph
+} Font_Cursor_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+int32_t fontengine_kerning(const Font_TypeDef *font, char left, char right);
+uint32_t fontengine_text_width(const Font_TypeDef *font, const char *text);
+uint32_t fontengine_fit(const Font_TypeDef *font, const char *text, uint32_t num_columns);
+uint32_t fontengine_center_line(const Font_TypeDef *font, const char *text, uint32_t length, uint32_t num_columns, char *line, uint32_t *first);
+uint32_t fontengine_render_mask(const Font_TypeDef *font, const char *text, uint16_t *mask, uint32_t num_columns, uint32_t x, uint32_t y);
+uint32_t fontengine_draw(POV_Frame_TypeDef *frame, const Font_TypeDef *font, const char *text, uint32_t x, uint32_t y, GRB_TypeDef color);
+void fontengine_cursor_init(Font_Cursor_TypeDef *cursor, const Font_TypeDef *font, const char *text);
+bool fontengine_cursor_next(Font_Cursor_TypeDef *cursor, uint16_t *column);
+
+#endif
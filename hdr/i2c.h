@@ -17,6 +17,15 @@
 #define READ_BIT		1u
 #define WRITE_BIT		0u
 
+#define I2C_QUEUE_DEPTH	4u		// Transactions queued per bus, including the one in flight; a power of two
+#define I2C_WORD_BYTES	4u		// Longest transfer in the word modes
+#define I2C_DMA_MIN_BYTES	4u	// Shorter transfers are cheaper byte by byte than setting up LDMA
+
+#define I2C_DEADLINE_MS		20u		// Time an attempt may run before the transaction is aborted
+#define I2C_NACK_RETRIES	6u		// Retries after a NACK, each after twice the backoff of the last
+#define I2C_BACKOFF_MS		2u		// Backoff before the first retry
+#define I2C_TICK_MS			2u		// Period of the deadline and backoff check while a bus is busy
+
 //***********************************************************************************
 // global variables
 //***********************************************************************************
@@ -33,14 +42,32 @@ typedef enum {
 
 	// Write states
 	Write_Data,
-	Write_Complete
+	Write_Complete,
+
+	// Error states; a STOP has been sent
+	Retry_Wait,
+	Failed
 } I2C_States;
 
+// Result of a transaction, stored through I2C_PAYLOAD.status before its
+// callback is scheduled
+typedef enum {
+	I2C_Ok,
+	I2C_No_Ack,				// The receiver NACKed through every retry
+	I2C_Timeout,			// The deadline passed, or a receiver held SCL low
+	I2C_Bus_Fault			// Arbitration lost, a misplaced START or STOP, or an illegal state
+} I2C_Status;
+
+// The word modes move up to I2C_WORD_BYTES bytes packed into a uint32_t; the
+// byte modes move byte_count bytes to or from a caller's buffer unchanged,
+// leaving the byte order to the caller.
 typedef enum {
 	R_MSB_First,
 	R_LSB_First,
 	W_MSB_First,
-	W_LSB_First
+	W_LSB_First,
+	R_Bytes,
+	W_Bytes
 } I2C_Mode;
 
 typedef struct {
@@ -64,20 +91,27 @@ typedef struct {
 	// CTRL register
 	I2C_ClockHLR_TypeDef ClockHLR;
 
+	// Move the data bytes of transfers of I2C_DMA_MIN_BYTES or more by LDMA
+	bool dma;
+
+	// Event for the deadline and backoff check, scheduled every I2C_TICK_MS
+	// while the bus is busy with the bus (0 or 1) as payload, and handed to
+	// i2c_tick(). Without one, only callers spinning on i2c_getBusy() run it.
+	uint32_t tick_cb;
 
 } I2C_OPEN_STRUCT;
 
 typedef struct {
 	uint32_t receiver_address;
 	uint32_t receiver_register;
-	uint32_t *i2c_data;
+	uint8_t *buffer;
 	I2C_States state;
-	bool busy;
 	I2C_TypeDef *i2c;
-	uint32_t cb;
 	I2C_Mode mode;
-	uint32_t count;
-	uint32_t i;
+	uint32_t count;				// Bytes to move
+	uint32_t i;					// Bytes moved so far
+	bool dma;					// Data bytes move by LDMA on dma_channel
+	unsigned int dma_channel;
 } I2C_STATE_MACHINE;
 
 typedef struct {
@@ -85,18 +119,53 @@ typedef struct {
 	uint32_t receiver_register;
 	I2C_TypeDef *i2c_peripheral;
 	uint32_t cb;
+	uint32_t cb_payload;		// Passed with cb to the scheduler
 	I2C_Mode mode;
 	uint32_t byte_count;
+	I2C_Status *status;			// Result of the transaction; may be NULL
 } I2C_PAYLOAD;
 
+// One queued transaction. In the word modes the bytes are held in word[],
+// unpacked from the caller's value when queued, and a read is packed into
+// result on completion. In the byte modes buffer is the caller's.
+typedef struct {
+	I2C_PAYLOAD payload;
+	uint8_t *buffer;
+	uint8_t word[I2C_WORD_BYTES];
+	uint32_t *result;			// Word reads only
+} I2C_TRANSACTION;
+
+// Interrupts taken and core cycles spent in them, over completed transactions
+typedef struct {
+	uint32_t transactions;
+	uint32_t bytes;
+	uint32_t interrupts;
+	uint32_t cycles;
+} I2C_Cost_TypeDef;
+
+typedef struct {
+	I2C_Cost_TypeDef irq;		// Every byte handled by the I2C interrupt
+	I2C_Cost_TypeDef dma;		// Data bytes moved by LDMA
+
+	// Failed transactions are not counted above
+	uint32_t retries;			// NACKs retried after a backoff
+	uint32_t no_acks;
+	uint32_t timeouts;
+	uint32_t bus_faults;
+	uint32_t recoveries;		// Bus resets that needed SCL clocked by hand
+} I2C_Stats_TypeDef;
+
 //***********************************************************************************
 // function prototypes
 //***********************************************************************************
 void i2c_open(I2C_TypeDef *i2c_peripheral, I2C_OPEN_STRUCT *i2c_settings);
 void I2C0_IRQHandler(void);
 void I2C1_IRQHandler(void);
-void i2c_start(I2C_PAYLOAD *payload, uint32_t *i2c_data);
+bool i2c_start(I2C_PAYLOAD *payload, uint32_t *i2c_data);
+bool i2c_start_bytes(I2C_PAYLOAD *payload, uint8_t *buffer);
 bool i2c_getBusy(I2C_TypeDef *i2c);
+void i2c_get_stats(I2C_TypeDef *i2c, I2C_Stats_TypeDef *stats, bool reset);
+void i2c_tick(uint32_t bus_index);
 
 #endif
 
@@ -0,0 +1,42 @@
+#ifndef IRQ_HG
+#define IRQ_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	NVIC priority plan; lower numbers preempt higher ones. Column emission and
+ *	hall capture sit above everything else so the display never waits on sensor,
+ *	flash or scheduler work. Every driver that enables an interrupt sets its
+ *	priority from this list.
+ */
+#define		IRQ_PRIORITY_COLUMN			0u		// WTIMER1: column ticks and display zone edges
+#define		IRQ_PRIORITY_HALL			1u		// GPIO hall sensor and buttons, WTIMER0 rotation measure
+#define		IRQ_PRIORITY_BACKGROUND		3u		// I2C, ADC, RTCC, LDMA, USART, other timers
+
+/*
+ *	Critical section for data shared with background interrupts only. It raises
+ *	BASEPRI to mask IRQ_PRIORITY_BACKGROUND and below, leaving the column and
+ *	hall interrupts running. Data shared with those still needs
+ *	CORE_ENTER_CRITICAL(), as does anything that sleeps, since an interrupt
+ *	masked by BASEPRI does not wake the core.
+ *
+ *		IRQ_DECLARE_STATE;
+ *		IRQ_ENTER_BACKGROUND();
+ *		...
+ *		IRQ_EXIT_BACKGROUND();
+ */
+#define		IRQ_BASEPRI_BACKGROUND		(IRQ_PRIORITY_BACKGROUND << (8u - __NVIC_PRIO_BITS))
+
+#define		IRQ_DECLARE_STATE			uint32_t irq_basepri
+#define		IRQ_ENTER_BACKGROUND()		do { irq_basepri = __get_BASEPRI(); __set_BASEPRI_MAX(IRQ_BASEPRI_BACKGROUND); } while (0)
+#define		IRQ_EXIT_BACKGROUND()		__set_BASEPRI(irq_basepri)
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef MARQUEE_HG
+#define MARQUEE_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fontengine.h"
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		MARQUEE_RING_COLUMNS		DISPLAY_NUM_PIXELS_WIDE
+#define		MARQUEE_GAP_COLUMNS			DISPLAY_NUM_PIXELS_WIDE	// Blank run so the text leaves before it repeats
+#define		MARQUEE_MAX_CATCHUP_MS		1000u	// Longer gaps (e.g. display stopped) are not replayed
+
+/*
+ *	The marquee keeps the frame as a ring of columns. Column offset of the ring is
+ *	shown first; each scroll step renders the single column that enters on the
+ *	right into the slot that just left on the left, and advances the offset.
+ */
+typedef struct {
+	const Font_TypeDef *font;
+	const char *text;					// Caller owned, must outlive the marquee
+	GRB_TypeDef color;
+	uint32_t columns_per_second;
+	uint32_t row;						// LED of the glyphs' bottom row
+	uint32_t source_columns;			// Text plus gap, in columns
+	uint32_t next_column;				// Source column that enters on the next step
+	Font_Cursor_TypeDef cursor;			// Positioned at next_column while in the text
+	uint32_t offset;					// Ring column shown at the left edge
+	uint32_t last_ms;
+	uint32_t step_remainder;			// Unspent time, in ms * columns_per_second
+	bool filled;
+} Marquee_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void marquee_init(Marquee_TypeDef *marquee, const Font_TypeDef *font, const char *text, GRB_TypeDef color, uint32_t columns_per_second);
+void marquee_set_speed(Marquee_TypeDef *marquee, uint32_t columns_per_second);
+uint32_t marquee_update(Marquee_TypeDef *marquee, POV_Frame_TypeDef *frame, uint32_t now_ms);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef MX25_HG
+#define MX25_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MX25_HOST_FILE
+#include "brd_config.h"
+#endif
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		MX25_CMD_READ					0x03
+#define		MX25_CMD_READ_ID				0x9F
+#define		MX25_CMD_DEEP_POWER_DOWN		0xB9
+#define		MX25_CMD_RELEASE_POWER_DOWN		0xAB
+
+#define		MX25_RELEASE_DELAY_MS			1u		// tRES1 is 30 us
+#define		MX25_MAX_READ_LEN				2048u	// One DMA descriptor
+#define		MX25_DUMMY_BYTE					0x00	// Keeps the shared MOSI line low
+
+/*
+ *	Define MX25_HOST_FILE to build a stand-in that serves reads from a file
+ *	(e.g. a flash image from tools/stream_pack.py) instead of the device. It
+ *	needs only the C library, e.g. gcc -DMX25_HOST_FILE -Ihdr -c src/mx25.c;
+ *	stream.c still needs em_core.h, so a host build must supply that itself.
+ *	Reads complete synchronously, inside mx25_read_async().
+ */
+
+typedef void (*MX25_Callback_TypeDef)(void);
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void mx25_open(void);
+void mx25_close(void);
+uint32_t mx25_read_id(void);
+void mx25_read(uint32_t address, void *dst, uint32_t length);
+void mx25_read_async(uint32_t address, void *dst, uint32_t length, MX25_Callback_TypeDef callback);
+void mx25_abort(void);
+bool mx25_busy(void);
+#ifdef MX25_HOST_FILE
+bool mx25_host_open(const char *path);
+#endif
+
+#endif
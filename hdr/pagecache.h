@@ -0,0 +1,42 @@
+#ifndef PAGECACHE_HG
+#define PAGECACHE_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		PAGECACHE_NUM_PAGES			4u		// 3456 bytes of RAM each
+
+/*
+ *	Rendered frames, keyed by a page number and the version of the content it was
+ *	rendered from. The caller bumps the version whenever the page's source data
+ *	changes; a page already rendered at that version is shown without rendering.
+ */
+typedef struct {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;					// Valid pages replaced by another page
+} PageCache_Stats_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void pagecache_init(void);
+const POV_Frame_TypeDef *pagecache_lookup(uint32_t page, uint32_t version);
+POV_Frame_TypeDef *pagecache_begin(uint32_t page, uint32_t version);
+const POV_Frame_TypeDef *pagecache_commit(POV_Frame_TypeDef *frame);
+void pagecache_get_stats(PageCache_Stats_TypeDef *stats);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef POLAR_HG
+#define POLAR_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Angles are binary angles (brads), 65536 to a full turn, measured from the
+ *	middle of the display zone in the direction of increasing column. One display
+ *	column is exactly 256 brads (1.40625 degrees), so the column of an angle is its
+ *	high byte, offset by half the zone.
+ *
+ *	Radii and Cartesian coordinates are Q8 fixed point in LED pitches, measured
+ *	from the axis of rotation. +y points to the middle of the display zone and +x
+ *	towards higher columns.
+ */
+#define		POLAR_FULL_TURN				65536u
+#define		POLAR_DEGREES(d)			((int32_t)(d) * (int32_t)POLAR_FULL_TURN / 360)
+#define		POLAR_BRADS_PER_COLUMN		256u
+#define		POLAR_ZONE_HALF				(DISPLAY_NUM_PIXELS_WIDE * POLAR_BRADS_PER_COLUMN / 2)
+
+#define		POLAR_FRACTION_BITS			8u
+#define		POLAR_ONE					(1 << POLAR_FRACTION_BITS)
+#define		POLAR_HUB_RADIUS			4u		// LED pitches from the axis to LED 0, approximate
+
+#define		POLAR_SIN_ONE				32767	// Q15 full scale of polar_sin()
+
+typedef uint16_t polar_angle_t;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+int32_t polar_sin(polar_angle_t angle);
+int32_t polar_cos(polar_angle_t angle);
+polar_angle_t polar_atan2(int32_t x, int32_t y, uint32_t *radius);
+void polar_point(polar_angle_t angle, int32_t radius, int32_t *x, int32_t *y);
+
+void polar_clear(POV_Frame_TypeDef *frame);
+void polar_sector(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color);
+void polar_arc(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, uint32_t led, GRB_TypeDef color);
+void polar_needle(POV_Frame_TypeDef *frame, polar_angle_t angle, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color);
+void polar_ticks(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, polar_angle_t step, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color);
+void polar_plot(POV_Frame_TypeDef *frame, int32_t x, int32_t y, GRB_TypeDef color);
+void polar_line(POV_Frame_TypeDef *frame, int32_t x0, int32_t y0, int32_t x1, int32_t y1, GRB_TypeDef color);
+void polar_circle(POV_Frame_TypeDef *frame, int32_t cx, int32_t cy, int32_t radius, GRB_TypeDef color);
+
+#endif
@@ -7,6 +7,7 @@
 #include "em_core.h"
 
 #include "brd_config.h"
+#include "textcell.h"
 #include "ws2812b.h"
 
 //***********************************************************************************
@@ -24,20 +25,27 @@
 #define		DISPLAY_NUM_PIXELS_WIDE		DISPLAY_NUM_CHARS * 6
 
 #define		TWO_SECONDS					MCU_HFRCO_FREQ * 2
+#define		POV_TICKS_PER_MS			(MCU_HFRCO_FREQ / 1000u)	// Measure timer runs at HFPERCLK
 
 #define		POV_MEASURE_TIMER			WTIMER0
 #define		POV_TICK_TIMER				WTIMER1
-#define		POV_INFO_LETIMER			LETIMER1
 
 #define		POV_INFO_TICK_RATE			2
 
+#define		POV_STREAM_ADDRESS			0u		// Stream image location in the MX25 flash
+
+#define		POV_BACKGROUND_QUIET_MS		3u		// Dark time needed before the next sweep to start background work
+
 #define		GPIO_EVEN_CB		0x0001
 #define		GPIO_ODD_CB			0x0002
 #define		BOOT_UP_CB			0x0004
-#define		SI7021_HUMIDITY_CB	0x0008
-#define		SI7021_TEMP_CB		0x0010
-#define		BMP280_TEMP_CB		0x0020
-#define		BMP280_PRESSURE_CB	0x0040
+#define		SENSORS_I2C_CB		0x0008		// Every sensor I2C transfer completes on this
+#define		SENSORS_DUE_CB		0x0010		// Payload is the sensor's id
+#define		SWTIMER_CB			0x0020
+#define		BATTERY_POLL_CB		0x0040
+#define		POV_RENDER_CB		0x0080
+#define		I2C_TICK_CB			0x0100		// Payload is the I2C bus
+#define		POV_MENU_CB			0x0200
 
 //***********************************************************************************
 // global variables
@@ -50,25 +58,31 @@ typedef enum {
 } pov_position;
 
 typedef struct {
-	char *top_string;
-	char *bottom_string;
-	GRB_TypeDef top_colors[DISPLAY_NUM_CHARS + 1];    // Extra character for string termination
-	GRB_TypeDef bottom_colors[DISPLAY_NUM_CHARS + 1];
+	TextCell_TypeDef top_text;
+	TextCell_TypeDef bottom_text;
+	GRB_TypeDef top_colors[TEXTCELL_CAPACITY + 1];    // Extra character for string termination
+	GRB_TypeDef bottom_colors[TEXTCELL_CAPACITY + 1];
 } POV_Display_TypeDef;
 
+// One full revolution's worth of LED columns, as sent to ws2812b_write()
+typedef GRB_TypeDef POV_Frame_TypeDef[DISPLAY_NUM_PIXELS_WIDE][WS2812B_NUM_LEDS];
+
 typedef enum {
 	HelloWorld,
 	TempHumidity,
 	Credits,
 	BatteryLevel,
 	PressureAltitude,
-	Filler6,
-	Filler7,
-	Filler8,
-	Filler9,
-	Filler10,
-	Filler11,
-	Filler12,
+	EffectGradient,
+	EffectPlasma,
+	EffectFire,
+	EffectColorCycle,
+	Marquee,
+	Animation,
+	Stream,
+	Gauges,
+	Clock,
+	POV_NUM_MODES
 } POV_DisplayMode_TypeDef;
 
 
@@ -76,14 +90,18 @@ typedef enum {
 // function prototypes
 //***********************************************************************************
 void pov_open(void);
+void pov_core(void);
+bool pov_background_ok(void);
 void pov_handle_measure(uint32_t count);
 void pov_start_display(void);
 void pov_end_display(void);
 void pov_tick(void);
 void pov_update_display(POV_Display_TypeDef display);
-void pov_update_humidity(void);
-void pov_update_si7021_temp(void);
-void pov_update_bmp280(void);
+bool pov_render_test(void);
+void pov_show_static_frame(const POV_Frame_TypeDef *frame);
+uint32_t pov_elapsed_ms(void);
+uint32_t pov_polar_max_cycles(void);
+uint32_t pov_column_max_latency(bool reset);
 void pov_show_menu(void);
 void pov_change_mode(bool direction);
 
@@ -0,0 +1,29 @@
+#ifndef POV_FRAMES_HG
+#define POV_FRAMES_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Static frames are rendered ahead of time by tools/framegen.py instead of by
+ *	pov_update_display(), laid out in font_small exactly as at run time. They are
+ *	placed in flash and never touched by the CPU until they are sent to the LEDs.
+ */
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+extern const POV_Frame_TypeDef pov_frame_credits;
+extern const POV_Frame_TypeDef pov_frame_filler;
+extern const POV_Frame_TypeDef pov_frame_low_battery;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef PT_HG
+#define PT_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Stackless coroutines (protothreads). A protothread is a function that can
+ *	stop at a wait and carry on from there the next time it is called. The only
+ *	state kept across a wait is the source line to resume at, so local variables
+ *	do not survive one; keep anything needed afterwards in statics.
+ *
+ *	The function is normally called again from the handler of the scheduler
+ *	event it is waiting on, and re-checks its wait condition each time. Waits
+ *	are implemented with a switch keyed on __LINE__, so a protothread may not
+ *	use switch itself around a wait, and may have only one wait per line.
+ *
+ *		static char sequence(PT_TypeDef *pt) {
+ *			PT_BEGIN(pt);
+ *			start_read(DONE_CB);
+ *			PT_WAIT_UNTIL(pt, read_done);
+ *			publish();
+ *			PT_END(pt);
+ *		}
+ */
+#define		PT_WAITING			0
+#define		PT_YIELDED			1
+#define		PT_EXITED			2
+#define		PT_ENDED			3
+
+#define		PT_INIT(pt)			((pt)->lc = 0)
+
+#define		PT_BEGIN(pt)		{ char pt_yielded = 1; (void)pt_yielded; switch ((pt)->lc) { case 0:
+
+#define		PT_END(pt)			} (void)pt_yielded; PT_INIT(pt); return PT_ENDED; }
+
+// Returns until cond is true when the protothread is next called
+#define		PT_WAIT_UNTIL(pt, cond)										\
+	do {																\
+		(pt)->lc = __LINE__; __attribute__((fallthrough)); case __LINE__:	\
+		if (!(cond)) {													\
+			return PT_WAITING;											\
+		}																\
+	} while (0)
+
+#define		PT_WAIT_WHILE(pt, cond)		PT_WAIT_UNTIL((pt), !(cond))
+
+// Returns once, carrying on from here on the next call
+#define		PT_YIELD(pt)												\
+	do {																\
+		pt_yielded = 0;													\
+		(pt)->lc = __LINE__; __attribute__((fallthrough)); case __LINE__:	\
+		if (pt_yielded == 0) {											\
+			return PT_YIELDED;											\
+		}																\
+	} while (0)
+
+// Starts again from PT_BEGIN on the next call
+#define		PT_RESTART(pt)		do { PT_INIT(pt); return PT_WAITING; } while (0)
+
+#define		PT_EXIT(pt)			do { PT_INIT(pt); return PT_EXITED; } while (0)
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+typedef struct {
+	uint16_t lc;							// Source line to resume at; 0 to start
+} PT_TypeDef;
+
+#endif
@@ -0,0 +1,39 @@
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef	RTCC_HG
+#define	RTCC_HG
+
+/* System include statements */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Silicon Labs include statements */
+#include "em_rtcc.h"
+
+/* The developer's include statements */
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define RTCC_HZ					1024u			// LFXO divided by 32
+#define RTCC_EM					EM3				// LFXO stops in EM3
+#define RTCC_MIN_LEAD			2u				// Ticks ahead a compare must be set to be sure to match
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void rtcc_open(void);
+void rtcc_compare_start(uint32_t tick, uint32_t cb);
+void rtcc_compare_stop(void);
+uint32_t rtcc_now(void);
+uint32_t rtcc_now_ms(void);
+
+void RTCC_IRQHandler(void);
+
+#endif
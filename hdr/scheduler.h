@@ -6,6 +6,7 @@
 
 /* System include statements */
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Silicon Labs include statements */
 
@@ -14,20 +15,37 @@
 //***********************************************************************************
 // defined files
 //***********************************************************************************
-
+#define SCHEDULER_NUM_EVENTS		32u			// One event per bit of a uint32_t event id
+#define SCHEDULER_NUM_PRIORITIES	8u			// 0 is lowest
+#define SCHEDULER_QUEUE_DEPTH		8u			// Queued events per priority
 
 //***********************************************************************************
 // global variables
 //***********************************************************************************
+typedef void (*Scheduler_Handler_TypeDef)(uint32_t payload);
+typedef bool (*Scheduler_Gate_TypeDef)(void);
 
+typedef struct {
+	uint32_t posted;
+	uint32_t dispatched;
+	uint32_t dropped;					// Queue for the event's priority was full
+	uint32_t coalesced;					// Merged into an instance already queued
+	uint32_t unhandled;					// Posted with no handler registered
+} Scheduler_Stats_TypeDef;
 
 //***********************************************************************************
 // function prototypes
 //***********************************************************************************
 void scheduler_open(void);
+void scheduler_register(uint32_t event, uint32_t priority, bool coalesce, Scheduler_Handler_TypeDef handler);
 void add_scheduled_event(uint32_t event);
+void add_scheduled_event_data(uint32_t event, uint32_t payload);
 void remove_scheduled_event(uint32_t event);
 uint32_t get_scheduled_events(void);
+void scheduler_set_gate(uint32_t priorities, Scheduler_Gate_TypeDef gate);
+bool scheduler_runnable(void);
+bool scheduler_dispatch(void);
+void scheduler_get_stats(uint32_t event, Scheduler_Stats_TypeDef *stats);
 
 
 #endif
@@ -0,0 +1,54 @@
+#ifndef SENSORS_HG
+#define SENSORS_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		SENSORS_NUM_VALUES			2u
+
+#define		SENSORS_SI7021_PERIOD_MS	2000u	// Default sampling periods
+#define		SENSORS_BMP280_PERIOD_MS	1000u
+#define		SENSORS_BATTERY_PERIOD_MS	1000u
+
+#define		SENSORS_TIMEOUT_MS			500u	// An I2C read not finished by then is abandoned
+
+typedef enum {
+	Sensor_SI7021,							// Humidity in 0.01 %RH, temperature in 0.1 F
+	Sensor_BMP280,							// Pressure in hPa, altitude in dm
+	Sensor_Battery,							// Charge in 0.01 %
+	SENSORS_NUM
+} Sensors_Id_TypeDef;
+
+/*
+ *	One published reading. seq counts every sample since sensors_open() and is 0
+ *	until the first; version only advances when the values differ from the
+ *	previous sample, so it can key rendered pages.
+ */
+typedef struct {
+	int32_t values[SENSORS_NUM_VALUES];
+	uint32_t timestamp_ms;					// rtcc_now_ms() when the sample completed
+	uint32_t seq;
+	uint32_t version;
+} Sensors_Sample_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void sensors_open(void);
+void sensors_set_period(Sensors_Id_TypeDef sensor, uint32_t period_ms);
+void sensors_sample(Sensors_Id_TypeDef sensor);
+void sensors_get(Sensors_Id_TypeDef sensor, Sensors_Sample_TypeDef *out);
+void sensors_i2c_done(Sensors_Id_TypeDef sensor);
+
+#endif
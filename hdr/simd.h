@@ -0,0 +1,70 @@
+#ifndef SIMD_HG
+#define SIMD_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "em_device.h"			// CMSIS intrinsics for the Cortex-M4 DSP extension
+#define SIMD_HARDWARE
+#endif
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Thin wrappers around the Cortex-M4 packed 8/16-bit instructions. On the target
+ *	each one is a single instruction; on any other compiler target (e.g. a Linux
+ *	host) they fall back to portable C with identical results.
+ *
+ *	Byte buffers such as a POV_Frame_TypeDef must be read through simd_word_t so
+ *	that the word accesses are not subject to strict aliasing.
+ */
+typedef uint32_t __attribute__((may_alias)) simd_word_t;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+// Per-byte unsigned saturating subtract: max(a - b, 0)
+static inline uint32_t simd_uqsub8(uint32_t a, uint32_t b) {
+#ifdef SIMD_HARDWARE
+	return __UQSUB8(a, b);
+#else
+	uint32_t result = 0;
+	for (uint32_t shift = 0; shift < 32; shift += 8) {
+		uint32_t x = (a >> shift) & 0xFF;
+		uint32_t y = (b >> shift) & 0xFF;
+		result |= ((x > y) ? x - y : 0) << shift;
+	}
+	return result;
+#endif
+}
+
+// Per-byte unsigned halving add: (a + b) / 2, without overflow
+static inline uint32_t simd_uhadd8(uint32_t a, uint32_t b) {
+#ifdef SIMD_HARDWARE
+	return __UHADD8(a, b);
+#else
+	return (a & b) + (((a ^ b) >> 1) & 0x7F7F7F7F);
+#endif
+}
+
+// Dual signed 16-bit multiply-accumulate: acc + a.lo * b.lo + a.hi * b.hi
+static inline int32_t simd_smlad(uint32_t a, uint32_t b, int32_t acc) {
+#ifdef SIMD_HARDWARE
+	return (int32_t)__SMLAD(a, b, (uint32_t)acc);
+#else
+	return acc + (int16_t)(a & 0xFFFF) * (int16_t)(b & 0xFFFF)
+			   + (int16_t)(a >> 16) * (int16_t)(b >> 16);
+#endif
+}
+
+// Packs two signed 16-bit values into one word for simd_smlad()
+static inline uint32_t simd_pack16(int16_t lo, int16_t hi) {
+	return ((uint32_t)(uint16_t)hi << 16) | (uint16_t)lo;
+}
+
+#endif
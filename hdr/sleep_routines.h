@@ -13,6 +13,7 @@
 //***********************************************************************************
 
 /* System include statements */
+#include <stdbool.h>
 #include <stdint.h>
 
 /* Silicon Labs include statements */
@@ -29,6 +30,13 @@
 #define 	EM4					4
 #define 	MAX_ENERGY_MODES	5
 
+typedef struct {
+	uint32_t elapsed_ms;
+	uint32_t wakeups;
+	uint32_t wakeups_per_sec;
+	uint16_t residency_permille[MAX_ENERGY_MODES];	// Share of elapsed time in each mode
+} Sleep_Stats_TypeDef;
+
 //***********************************************************************************
 // global variables
 //***********************************************************************************
@@ -41,6 +49,8 @@ void sleep_open(void);
 void sleep_block_mode(uint32_t EM);
 void sleep_unblock_mode(uint32_t EM);
 void enter_sleep(void);
+void sleep_idle(bool (*work_pending)(void));
+void sleep_get_stats(Sleep_Stats_TypeDef *stats, bool reset);
 uint32_t current_block_energy_mode(void);
 
 #endif
@@ -0,0 +1,70 @@
+#ifndef SPRITE_HG
+#define SPRITE_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		SPRITE_MAX_COLORS			16u
+#define		SPRITE_RUN_SHIFT			4u
+#define		SPRITE_INDEX_MASK			0x0Fu
+#define		SPRITE_MAX_RUN				16u
+
+/*
+ *	Sprite frame encoding, produced by tools/sprite_convert.py:
+ *
+ *	Each frame is a stream of pixels in display order: column 0 LED 0 to LED 11,
+ *	then column 1, and so on for width columns. The stream is run-length coded
+ *	one byte per run,
+ *
+ *		bits 7-4	run length - 1 (1 to 16 pixels)
+ *		bits 3-0	palette index
+ *
+ *	and runs may cross column boundaries. A frame therefore decodes in at most
+ *	width * WS2812B_NUM_LEDS byte reads, which bounds the cost per revolution.
+ */
+typedef struct {
+	uint16_t width;						// Columns, at most DISPLAY_NUM_PIXELS_WIDE
+	uint16_t frame_count;
+	uint16_t frame_ms;					// Time each frame is shown
+	const GRB_TypeDef *palette;			// Up to SPRITE_MAX_COLORS entries
+	const uint8_t *data;				// All frames, back to back
+	const uint32_t *frame_offsets;		// Start of each frame in data
+} Sprite_TypeDef;
+
+typedef struct {
+	const Sprite_TypeDef *sprite;
+	uint32_t start_ms;
+	uint32_t frame;						// Frame currently in the framebuffer
+	uint32_t x;							// First display column of the sprite
+	bool decoded;
+} Sprite_Player_TypeDef;
+
+typedef struct {
+	uint32_t last_cycles;				// Cost of the most recent decode
+	uint32_t max_cycles;
+	uint32_t decodes;
+} Sprite_Stats_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void sprite_play(Sprite_Player_TypeDef *player, const Sprite_TypeDef *sprite, uint32_t now_ms);
+bool sprite_due(const Sprite_Player_TypeDef *player, uint32_t now_ms);
+bool sprite_update(Sprite_Player_TypeDef *player, POV_Frame_TypeDef *frame, uint32_t now_ms);
+void sprite_decode_frame(const Sprite_TypeDef *sprite, uint32_t frame_index, POV_Frame_TypeDef *frame, uint32_t x);
+void sprite_get_stats(Sprite_Stats_TypeDef *stats);
+
+#endif
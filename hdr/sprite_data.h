@@ -0,0 +1,17 @@
+#ifndef SPRITE_DATA_HG
+#define SPRITE_DATA_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "sprite.h"
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+/*
+ *	Animations generated by tools/sprite_convert.py, one src/sprite_<name>.c each.
+ */
+extern const Sprite_TypeDef sprite_heart;
+
+#endif
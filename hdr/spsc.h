@@ -0,0 +1,80 @@
+#ifndef SPSC_HG
+#define SPSC_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Lock-free single-producer/single-consumer ring of event and payload pairs.
+ *	The producer only writes head and the consumer only writes tail, each with
+ *	a single aligned store, so neither side masks interrupts. The indices run
+ *	freely and are masked on use; head - tail is the fill level.
+ *
+ *	Exactly one context may push and one may pop. Interrupts that cannot
+ *	preempt each other, such as those sharing an NVIC priority, count as one
+ *	producer.
+ */
+#define		SPSC_DEPTH			8u			// Entries per ring; a power of two up to 128
+
+typedef struct {
+	volatile uint8_t head;					// Next entry to write; producer only
+	volatile uint8_t tail;					// Next entry to read; consumer only
+	volatile uint32_t dropped;				// Pushes refused while full; producer only
+	uint32_t event[SPSC_DEPTH];
+	uint32_t payload[SPSC_DEPTH];
+} Spsc_Ring_TypeDef;
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+
+// Empties a ring; only while neither side is using it
+static inline void spsc_init(Spsc_Ring_TypeDef *ring) {
+	ring->head = 0;
+	ring->tail = 0;
+	ring->dropped = 0;
+}
+
+static inline bool spsc_empty(const Spsc_Ring_TypeDef *ring) {
+	return ring->head == ring->tail;
+}
+
+// Producer side. Returns false, and counts the drop, if the ring is full.
+static inline bool spsc_push(Spsc_Ring_TypeDef *ring, uint32_t event, uint32_t payload) {
+	uint8_t head = ring->head;
+
+	if ((uint8_t)(head - ring->tail) >= SPSC_DEPTH) {
+		ring->dropped++;
+		return false;
+	}
+	ring->event[head & (SPSC_DEPTH - 1u)] = event;
+	ring->payload[head & (SPSC_DEPTH - 1u)] = payload;
+	__DMB();								// Entry is written before it is published
+	ring->head = head + 1u;
+	return true;
+}
+
+// Consumer side. Returns false if the ring is empty.
+static inline bool spsc_pop(Spsc_Ring_TypeDef *ring, uint32_t *event, uint32_t *payload) {
+	uint8_t tail = ring->tail;
+
+	if (tail == ring->head) {
+		return false;
+	}
+	__DMB();								// Entry is read after head is seen
+	*event = ring->event[tail & (SPSC_DEPTH - 1u)];
+	*payload = ring->payload[tail & (SPSC_DEPTH - 1u)];
+	__DMB();								// and before its slot is handed back
+	ring->tail = tail + 1u;
+	return true;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef STREAM_HG
+#define STREAM_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pov.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		STREAM_MAGIC				0x53564F50u		// "POVS"
+#define		STREAM_VERSION				1u
+#define		STREAM_RING_FRAMES			3u
+#define		STREAM_FRAME_BYTES			sizeof(POV_Frame_TypeDef)
+
+/*
+ *	Flash image layout, produced by tools/stream_pack.py. All fields are little
+ *	endian. Frames are raw POV_Frame_TypeDef contents, frame_bytes apart,
+ *	starting at data_offset from the header.
+ */
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t width;						// Must be DISPLAY_NUM_PIXELS_WIDE
+	uint32_t frame_count;
+	uint32_t frame_ms;
+	uint32_t frame_bytes;				// Must be STREAM_FRAME_BYTES
+	uint32_t data_offset;
+} Stream_Header_TypeDef;
+
+typedef struct {
+	uint32_t frames_loaded;
+	uint32_t underruns;					// Revolutions where the due frame was not loaded
+	uint32_t aborted;					// Reads cut short by the start of the display zone
+} Stream_Stats_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+bool stream_open(uint32_t address, uint32_t now_ms);
+void stream_close(void);
+void stream_prefetch(uint32_t now_ms);
+void stream_end_prefetch(void);
+const POV_Frame_TypeDef *stream_acquire(uint32_t now_ms);
+void stream_get_stats(Stream_Stats_TypeDef *stats);
+
+#endif
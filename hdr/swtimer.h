@@ -0,0 +1,50 @@
+#ifndef SWTIMER_HG
+#define SWTIMER_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rtcc.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		SWTIMER_LEVEL_BITS			6u
+#define		SWTIMER_SLOTS				(1u << SWTIMER_LEVEL_BITS)		// Slots per level
+#define		SWTIMER_LEVELS				4u
+#define		SWTIMER_MAX_TICKS			((SWTIMER_SLOTS - 1u) << (SWTIMER_LEVEL_BITS * (SWTIMER_LEVELS - 1u)))	// About 4.5 hours
+#define		SWTIMER_MS_TO_TICKS(ms)		((uint32_t)(((uint64_t)(ms) * RTCC_HZ + 500u) / 1000u))
+
+/*
+ *	A timer owned by the caller. A zeroed timer is stopped. It must stay in scope
+ *	while running, and is only touched through swtimer_*() from thread context.
+ */
+typedef struct SwTimer_TypeDef {
+	struct SwTimer_TypeDef *next;			// Links in the wheel slot; NULL prev while stopped
+	struct SwTimer_TypeDef **prev;
+	uint32_t expires;						// RTCC tick
+	uint32_t period;						// Ticks; 0 for one-shot
+	uint32_t event;
+	uint32_t payload;
+	uint8_t level;							// Wheel slot while running
+	uint8_t slot;
+} SwTimer_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void swtimer_open(uint32_t wake_cb);
+void swtimer_start(SwTimer_TypeDef *timer, uint32_t delay_ms, uint32_t period_ms, uint32_t event, uint32_t payload);
+void swtimer_stop(SwTimer_TypeDef *timer);
+bool swtimer_running(const SwTimer_TypeDef *timer);
+void swtimer_service(void);
+
+#endif
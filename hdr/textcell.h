@@ -0,0 +1,39 @@
+#ifndef TEXTCELL_HG
+#define TEXTCELL_HG
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include <stdint.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define		TEXTCELL_CAPACITY			20u		// One display line; what does not fit in font_small is clipped
+#define		TEXTCELL_OVERFLOW_CHAR		'#'		// Fills a field whose value does not fit
+
+typedef enum {
+	TextCell_Left,
+	TextCell_Right,
+	TextCell_Center
+} TextCell_Align_TypeDef;
+
+typedef struct {
+	char text[TEXTCELL_CAPACITY + 1];			// Always NUL terminated
+	uint32_t length;
+} TextCell_TypeDef;
+
+//***********************************************************************************
+// global variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// function prototypes
+//***********************************************************************************
+void textcell_clear(TextCell_TypeDef *cell);
+void textcell_append_str(TextCell_TypeDef *cell, const char *str, uint32_t width, TextCell_Align_TypeDef align);
+void textcell_append_fixed(TextCell_TypeDef *cell, int32_t value, uint32_t decimals, uint32_t width, TextCell_Align_TypeDef align);
+void textcell_finish(TextCell_TypeDef *cell, TextCell_Align_TypeDef align);
+
+#endif
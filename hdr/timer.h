@@ -10,6 +10,9 @@
 /* Silicon Labs include statements */
 #include "em_timer.h"
 
+/* The developer's include statements */
+#include "irq.h"
+
 //***********************************************************************************
 // defined files
 //***********************************************************************************
@@ -17,7 +20,7 @@
 #define	TIMER_ATI_ENABLE			false
 #define	TIMER_MODE					timerModeUp
 
-#define	TIMER_EM					EM3
+#define	TIMER_EM					EM2				// HF timers stop in EM2
 
 typedef struct {
 	bool enable;
@@ -27,6 +30,7 @@ typedef struct {
 	TIMER_InputAction_TypeDef fallAction;
 	TIMER_InputAction_TypeDef riseAction;
 	bool oneShot;
+	uint32_t irq_priority;				// NVIC priority, from irq.h
 } TIMER_MEASURE_TypeDef;
 
 //***********************************************************************************
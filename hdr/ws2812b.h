@@ -42,7 +42,6 @@
 #define	WS2812B_TX_ROUTE	USART_ROUTELOC0_TXLOC_LOC29
 
 // DMA settings
-#define WS2812B_DMA_CHANNEL				0u
 #define WS2812B_DMA_PERIPHERAL_SIGNAL	dmadrvPeripheralSignal_USART2_TXBL
 
 typedef struct {
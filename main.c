@@ -46,12 +46,14 @@ int main(void)
     // must be called from the super loop.
     sl_system_process_action();
 
-    run_scheduled_events(get_scheduled_events());
-
+    run_scheduled_events();
 
 #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
     // Let the CPU go to sleep if the system allows it.
     sl_power_manager_sleep();
+#else
+    // Sleep until the next interrupt unless an event is already waiting.
+    app_idle();
 #endif
   }
 #endif // SL_CATALOG_KERNEL_PRESENT
@@ -21,6 +21,7 @@
 // Static / Private Variables
 //***********************************************************************************
 static uint32_t data;
+static I2C_Status status;
 
 //***********************************************************************************
 // Private functions
@@ -44,9 +45,11 @@ static uint32_t data;
  * @param[in] enable
  * 		Whether or not to enable the I2C peripheral.
  *
+ * @param[in] tick_cb
+ * 		The event on which the application calls i2c_tick() for this bus.
  *
  ******************************************************************************/
-void si7021_i2c_open(I2C_TypeDef *i2c, bool enable) {
+void si7021_i2c_open(I2C_TypeDef *i2c, bool enable, uint32_t tick_cb) {
 	I2C_OPEN_STRUCT settings;
 
 	timer_delay(80);
@@ -62,6 +65,8 @@ void si7021_i2c_open(I2C_TypeDef *i2c, bool enable) {
 	settings.freq = I2C_FREQ_FAST_MAX;
 	settings.refFreq = 0;
 	settings.controller = true;
+	settings.dma = true;
+	settings.tick_cb = tick_cb;
 
 	i2c_open(i2c, &settings);
 }
@@ -72,6 +77,7 @@ void si7021_i2c_open(I2C_TypeDef *i2c, bool enable) {
  *
  * @details
  *		Will not return any values, only store the result in the private data variable defined in SI7021.c.
+ *		The command is queued behind any other transfers on the bus.
  *
  * @param[in] command
  * 		The command to send to the Si7021.
@@ -79,23 +85,29 @@ void si7021_i2c_open(I2C_TypeDef *i2c, bool enable) {
  * @param[in] cb
  * 		The function to be scheduled when the transaction is complete.
  *
- * @param[in] mode
- * 		The mode in which to operate (R_Single_Byte or R_MSB_First)
+ * @param[in] cb_payload
+ * 		The payload scheduled with cb.
+ *
+ * @param[in] byte_count
+ * 		The number of bytes to read; 2 for a measurement without checksum.
+ *
+ * @return
+ * 		False if the bus's queue was full.
  *
  ******************************************************************************/
-void si7021_read(uint32_t command, uint32_t cb, uint32_t byte_count) {
+bool si7021_read(uint32_t command, uint32_t cb, uint32_t cb_payload, uint32_t byte_count) {
 	I2C_PAYLOAD payload = {
 			.receiver_address = SI7021_RECEIVER_ADDRESS,
 			.receiver_register = command,
 			.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
 			.cb = cb,
+			.cb_payload = cb_payload,
 			.mode = R_MSB_First,
-			.byte_count = byte_count
+			.byte_count = byte_count,
+			.status = &status
 	};
 
-	if ((ENVSENSE_I2C_PERIPHERAL->STATE & _I2C_STATE_STATE_MASK) == I2C_STATE_STATE_IDLE) {
-		i2c_start(&payload, &data);
-	}
+	return i2c_start(&payload, &data);
 }
 
 /***************************************************************************//**
@@ -114,20 +126,32 @@ void si7021_read(uint32_t command, uint32_t cb, uint32_t byte_count) {
  * @param[in] cb
  * 		The function to be scheduled when the transaction is complete.
  *
+ * @return
+ * 		False if the bus's queue was full.
+ *
  ******************************************************************************/
-void si7021_write(uint32_t user_register, uint32_t *command, uint32_t cb) {
-	if ((ENVSENSE_I2C_PERIPHERAL->STATE & _I2C_STATE_STATE_MASK) == I2C_STATE_STATE_IDLE) {
-		I2C_PAYLOAD payload = {
-				.receiver_address = SI7021_RECEIVER_ADDRESS,
-				.receiver_register = user_register,
-				.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
-				.cb = cb,
-				.mode = W_MSB_First,
-				.byte_count = 1
-		};
-
-		i2c_start(&payload, command);
-	}
+bool si7021_write(uint32_t user_register, uint32_t *command, uint32_t cb) {
+	I2C_PAYLOAD payload = {
+			.receiver_address = SI7021_RECEIVER_ADDRESS,
+			.receiver_register = user_register,
+			.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
+			.cb = cb,
+			.mode = W_MSB_First,
+			.byte_count = 1,
+			.status = &status
+	};
+
+	return i2c_start(&payload, command);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the result of the last read or write; the private data variable
+ *		is only valid after a read if this is I2C_Ok.
+ *
+ ******************************************************************************/
+I2C_Status si7021_get_status(void) {
+	return status;
 }
 
 /***************************************************************************//**
@@ -157,6 +181,39 @@ float si7021_calculate_temperature() {
 	return temperature;
 }
 
+/***************************************************************************//**
+ * @brief
+ *		Integer version of si7021_calculate_humidity().
+ *
+ * @details
+ *		Same datasheet formula scaled by 100, so no floating point is needed to
+ *		format the result.
+ *
+ * @return
+ * 		Relative humidity in hundredths of a percent.
+ *
+ ******************************************************************************/
+int32_t si7021_calculate_humidity_centi(void) {
+	return (int32_t)((12500u * (data & 0xFFFF)) >> 16) - 600;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Integer version of si7021_calculate_temperature().
+ *
+ * @details
+ *		Computes hundredths of a degree Celsius with the datasheet formula, then
+ *		converts to tenths of a degree Fahrenheit.
+ *
+ * @return
+ * 		Temperature in tenths of a degree Fahrenheit.
+ *
+ ******************************************************************************/
+int32_t si7021_calculate_temperature_deci_f(void) {
+	int32_t centi_c = (int32_t)((17572u * (data & 0xFFFF)) >> 16) - 4685;
+	return (centi_c * 18) / 100 + 320;
+}
+
 /***************************************************************************//**
  * @brief
  *		TDD routine to validate that the Si7021 and I2C peripheral are configured
@@ -196,6 +253,8 @@ bool si7021_i2c_test(uint32_t cb) {
 	payload.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL;
 	payload.mode = R_MSB_First;
 	payload.receiver_address = SI7021_RECEIVER_ADDRESS;
+	payload.cb_payload = 0;
+	payload.status = &status;
 
 	uint32_t original_register_value;
 	i2c_start(&payload, &original_register_value);
@@ -11,6 +11,7 @@
 #include "adc.h"
 #include "em_cmu.h"
 #include "brd_config.h"
+#include "irq.h"
 
 //***********************************************************************************
 // defined files
@@ -78,6 +79,7 @@ void adc_open(ADC_TypeDef *adc, ADC_OPEN_STRUCT_TypeDef *open_struct) {
 	adc->IEN = ien_flags;
 
 	// Cleanup
+	NVIC_SetPriority(ADC0_IRQn, IRQ_PRIORITY_BACKGROUND);
 	NVIC_EnableIRQ(ADC0_IRQn);
 	sleep_unblock_mode(ADC_EM);
 }
@@ -2,7 +2,7 @@
  * @file app.c
  * @author Peter Magro
  * @date August 4th, 2021
- * @brief app.c contains functions for enabling the LETIMER0 and peripherals.
+ * @brief app.c contains functions for enabling the peripherals and dispatching events.
  */
 
 //***********************************************************************************
@@ -20,23 +20,33 @@
 #include "gpio.h"
 #include "HW_delay.h"
 #include "i2c.h"
-#include "letimer.h"
 #include "si7021.h"
 #include "timer.h"
 #include "pov.h"
+#include "sensors.h"
+#include "swtimer.h"
 #include "usart.h"
 #include "ws2812b.h"
-#include "font.h"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
+#define		APP_PRIORITY_INPUT		6u		// Buttons and the menu answer at once
+#define		APP_PRIORITY_TIMER		5u		// Expiries are posted from here
+#define		APP_PRIORITY_BOOT		4u
+#define		APP_PRIORITY_RENDER		3u		// Frame ready before the next sweep
+#define		APP_PRIORITY_I2C		2u		// Keeps the shared bus moving
+#define		APP_PRIORITY_SAMPLE		1u
+
+// Background priorities, run only in the dark part of a revolution
+#define		APP_BACKGROUND_PRIORITIES	((1u << (APP_PRIORITY_RENDER + 1u)) - (1u << APP_PRIORITY_SAMPLE))
 
 /*
  * Uncomment to enable TDD function calls
  */
 //#define SI7021_TEST_ENABLED
 //#define BMP280_TEST_ENABLED
+//#define POV_RENDER_TEST_ENABLED
 
 //***********************************************************************************
 // Static / Private Variables
@@ -47,6 +57,14 @@
 // Private functions
 //***********************************************************************************
 
+/***************************************************************************//**
+ * @brief
+ *		Returns true if any event is waiting and allowed to be dispatched.
+ *
+ ******************************************************************************/
+static bool app_events_pending(void) {
+	return scheduler_runnable();
+}
 
 //********************//
 // Callback Functions //
@@ -56,11 +74,11 @@
  *		Boot up callback function.
  *
  * @details
- *		Starts the POV measure timers and battery polling timer. Also calls SI7021
- *		and BMP280 TDD functions, if enabled.
+ *		Starts the POV measure timers and battery polling timer. Also calls SI7021,
+ *		BMP280 and text rendering TDD functions, if enabled.
  *
  ******************************************************************************/
-void scheduled_boot_up_cb(void) {
+void scheduled_boot_up_cb(uint32_t payload) {
 
 #ifdef SI7021_TEST_ENABLED
 	si7021_i2c_test(0);
@@ -68,64 +86,142 @@ void scheduled_boot_up_cb(void) {
 #ifdef BMP280_TEST_ENABLED
 	bmp280_i2c_test(0);
 #endif
-	remove_scheduled_event(BOOT_UP_CB);
+#ifdef POV_RENDER_TEST_ENABLED
+	pov_render_test();
+#endif
 	timer_start(POV_MEASURE_TIMER, TWO_SECONDS, UINT32_MAX);
-	letimer_start(BATTERY_LETIMER, true);
+	battery_start();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Button 0 callback function.
+ *
+ * @details
+ *		Posted by the even GPIO interrupt, so the mode changes and the menu is
+ *		drawn from the main loop rather than in an interrupt the column
+ *		interrupt can preempt.
+ *
+ ******************************************************************************/
+void scheduled_gpio_even_cb(uint32_t payload) {
+	pov_change_mode(true);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Button 1 callback function.
+ *
+ ******************************************************************************/
+void scheduled_gpio_odd_cb(uint32_t payload) {
+	pov_change_mode(false);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		POV menu callback function.
+ *
+ * @details
+ *		Posted by the measure timer when the display stops spinning.
+ *
+ ******************************************************************************/
+void scheduled_pov_menu_cb(uint32_t payload) {
+	pov_show_menu();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Sensor I2C callback function.
+ *
+ * @details
+ *		Scheduled when any sensor I2C transfer completes, with the sensor's id as
+ *		payload. Resumes that sensor's read sequence.
+ *
+ ******************************************************************************/
+void scheduled_sensors_i2c_cb(uint32_t payload) {
+	sensors_i2c_done((Sensors_Id_TypeDef)payload);
 }
 
 /***************************************************************************//**
  * @brief
- *		SI7021 humidity callback function.
+ *		Sensor sampling callback function.
  *
  * @details
- *		Updates the humidity variable in pov.c and begins a temperature read.
+ *		Scheduled by a sensor's software timer when its sampling period
+ *		elapses. The payload is the sensor's id; every sensor shares the event,
+ *		so it is queued per post rather than coalesced.
  *
  ******************************************************************************/
-void scheduled_si7021_humidity_cb(void) {
-	remove_scheduled_event(SI7021_HUMIDITY_CB);
-	pov_update_humidity();
-	si7021_read(SI7021_TEMPERATURE_NO_HOLD, SI7021_TEMP_CB, R_MSB_First);
+void scheduled_sensor_due_cb(uint32_t payload) {
+	sensors_sample(payload);
 }
 
 /***************************************************************************//**
  * @brief
- *		SI7021 temperature callback function.
+ *		POV render callback function.
  *
  * @details
- *		Updates the temperature variable in pov.c.
+ *		Scheduled at the end of every display zone, and at the first hall
+ *		pulse after the display was stopped.
  *
  ******************************************************************************/
-void scheduled_si7021_temp_cb(void) {
-	remove_scheduled_event(SI7021_TEMP_CB);
-	pov_update_si7021_temp();
+void scheduled_pov_render_cb(uint32_t payload) {
+	pov_core();
 }
 
 /***************************************************************************//**
  * @brief
- *		BMP280 temperature callback function.
+ *		Software timer callback function.
  *
  * @details
- *		Begins a pressure read.
+ *		Scheduled by the RTCC when the timer wheel has expiries due.
  *
  ******************************************************************************/
-void scheduled_bmp280_temp_cb(void) {
-	remove_scheduled_event(BMP280_TEMP_CB);
-	bmp280_read_pressure();
+void scheduled_swtimer_cb(uint32_t payload) {
+	swtimer_service();
 }
 
 /***************************************************************************//**
  * @brief
- *		BMP280 pressure callback function.
+ *		Battery polling callback function.
+ *
+ ******************************************************************************/
+void scheduled_battery_poll_cb(uint32_t payload) {
+	battery_poll();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		I2C tick callback function.
  *
  * @details
- *		Calls pov_update_bmp280().
+ *		Scheduled by an I2C bus's software timer while the bus is busy, with
+ *		the bus as payload. Makes retries and enforces transaction deadlines.
  *
  ******************************************************************************/
-void scheduled_bmp280_pressure_cb(void) {
-	remove_scheduled_event(BMP280_PRESSURE_CB);
-	pov_update_bmp280();
+void scheduled_i2c_tick_cb(uint32_t payload) {
+	i2c_tick(payload);
 }
 
+// Every event the application handles. Interrupt-driven events are posted
+// whenever they fire; each is dispatched through this table only.
+static const struct {
+	uint32_t event;
+	uint32_t priority;
+	bool coalesce;
+	Scheduler_Handler_TypeDef handler;
+} app_events[] = {
+	{ GPIO_EVEN_CB,			APP_PRIORITY_INPUT,		false,	scheduled_gpio_even_cb },
+	{ GPIO_ODD_CB,			APP_PRIORITY_INPUT,		false,	scheduled_gpio_odd_cb },
+	{ POV_MENU_CB,			APP_PRIORITY_INPUT,		true,	scheduled_pov_menu_cb },
+	{ SWTIMER_CB,			APP_PRIORITY_TIMER,		true,	scheduled_swtimer_cb },
+	{ BOOT_UP_CB,			APP_PRIORITY_BOOT,		false,	scheduled_boot_up_cb },
+	{ POV_RENDER_CB,		APP_PRIORITY_RENDER,	true,	scheduled_pov_render_cb },
+	{ SENSORS_I2C_CB,		APP_PRIORITY_I2C,		false,	scheduled_sensors_i2c_cb },
+	{ I2C_TICK_CB,			APP_PRIORITY_I2C,		false,	scheduled_i2c_tick_cb },
+	{ SENSORS_DUE_CB,		APP_PRIORITY_SAMPLE,	false,	scheduled_sensor_due_cb },
+	{ BATTERY_POLL_CB,		APP_PRIORITY_SAMPLE,	true,	scheduled_battery_poll_cb },
+};
+
 //***********************************************************************************
 // Global functions
 //***********************************************************************************
@@ -135,20 +231,25 @@ void scheduled_bmp280_pressure_cb(void) {
  *		Opens all peripherals.
  *
  * @details
- *		Opens CMU, GPIO, sleep mode manager, scheduler, battery, and POV app.
+ *		Opens CMU, GPIO, sleep mode manager, scheduler, software timers, battery,
+ *		sensor service, and POV app.
  *
  ******************************************************************************/
 void app_peripheral_setup(void) {
 
-	// System preparation
-	sleep_block_mode(SYSTEM_BLOCK_EM);
-
 	// Open peripherals
 	cmu_open();
 	gpio_open(GPIO_EVEN_CB, GPIO_ODD_CB);
 	sleep_open();
+	sleep_block_mode(SYSTEM_BLOCK_EM);		// After sleep_open(), which clears all blocks
 	scheduler_open();
-	battery_open();
+	for (uint32_t i = 0; i < sizeof(app_events) / sizeof(app_events[0]); i++) {
+		scheduler_register(app_events[i].event, app_events[i].priority, app_events[i].coalesce, app_events[i].handler);
+	}
+	scheduler_set_gate(APP_BACKGROUND_PRIORITIES, pov_background_ok);
+	swtimer_open(SWTIMER_CB);
+	battery_open(BATTERY_POLL_CB);
+	sensors_open();
 	pov_open();
 
 	// Cleanup
@@ -160,29 +261,29 @@ void app_peripheral_setup(void) {
  *		Runs all events from the scheduler.
  *
  * @details
- *		Gets scheduled events from the scheduler, then calls each CB function as needed.
+ *		Dispatches events, highest priority first, until none are left. Events
+ *		posted by a handler are run in the same call.
  *
  * @note
- *		Callback macros are defined in app.h.
+ *		Events and their handlers are listed in app_events[].
  *
  ******************************************************************************/
-void run_scheduled_events(uint32_t scheduled_events) {
-
-	if (scheduled_events & BOOT_UP_CB) {
-		scheduled_boot_up_cb();
-	}
-
-	if (scheduled_events & SI7021_HUMIDITY_CB) {
-		scheduled_si7021_humidity_cb();
-	}
-
-	if (scheduled_events & SI7021_TEMP_CB) {
-		scheduled_si7021_temp_cb();
-	}
+void run_scheduled_events(void) {
+	while (scheduler_dispatch());
+}
 
-	if (scheduled_events & BMP280_TEMP_CB) {
-		scheduled_bmp280_temp_cb();
-	}
+/***************************************************************************//**
+ * @brief
+ *		Sleeps in the deepest allowed energy mode until the next interrupt, if
+ *		no events are waiting.
+ *
+ * @details
+ *		Called from the main loop after run_scheduled_events(). An event posted
+ *		by an interrupt after the queue was found empty still ends the sleep.
+ *
+ ******************************************************************************/
+void app_idle(void) {
+	sleep_idle(app_events_pending);
 }
 
 /*
@@ -193,9 +294,9 @@ void run_scheduled_events(uint32_t scheduled_events) {
  *		Handles interrupts from even GPIO.
  *
  * @details
- *		Interrupts raised by buttons will change what's shown on the display.
- *		Interrupts raised by the hall effect sensor will call the POV calibration
- *		function.
+ *		Interrupts raised by buttons schedule a change of what's shown on the
+ *		display. Interrupts raised by the hall effect sensor will call the POV
+ *		calibration function.
  *
  ******************************************************************************/
 void GPIO_EVEN_IRQHandler(void) {
@@ -204,7 +305,7 @@ void GPIO_EVEN_IRQHandler(void) {
 
 	// Interrupts from buttons
 	if (int_flag & (1u << BUTTON_0_INT_NUM)) {
-		pov_change_mode(true);
+		add_scheduled_event(GPIO_EVEN_CB);
 	}
 
 	// Interrupts from Hall effect sensor
@@ -219,7 +320,8 @@ void GPIO_EVEN_IRQHandler(void) {
  *		Handles interrupts from odd GPIO.
  *
  * @details
- *		Interrupts raised by buttons will change what's shown on the display.
+ *		Interrupts raised by buttons schedule a change of what's shown on the
+ *		display.
  *
  ******************************************************************************/
 void GPIO_ODD_IRQHandler(void) {
@@ -228,6 +330,6 @@ void GPIO_ODD_IRQHandler(void) {
 
 	// Interrupts from buttons
 	if (int_flag & (1u << BUTTON_1_INT_NUM)) {
-		pov_change_mode(false);
+		add_scheduled_event(GPIO_ODD_CB);
 	}
 }
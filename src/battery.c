@@ -14,12 +14,15 @@
 //***********************************************************************************
 // defined files
 //***********************************************************************************
-#define fmin(x, y)	((x < y) ? x : y)
+#define BATTERY_MAX_COUNT	((uint32_t)(BATTERY_ADC_FULL_SCALE * (BATTERY_MAX_V / BATTERY_ADC_REF_V)))
+#define BATTERY_MIN_COUNT	((uint32_t)(BATTERY_ADC_FULL_SCALE * (BATTERY_MIN_V / BATTERY_ADC_REF_V)))
 
 //***********************************************************************************
 // Static / Private Variables
 //***********************************************************************************
 static uint32_t consecutive_low_reads;
+static uint32_t poll_event;
+static SwTimer_TypeDef poll_timer;
 
 //***********************************************************************************
 // Private functions
@@ -31,20 +34,23 @@ static uint32_t consecutive_low_reads;
 //***********************************************************************************
 /***************************************************************************//**
  * @brief
- *		Opens the ADC and LETIMER for battery readings.
+ *		Opens the ADC for battery readings.
  *
  * @details
- *		ADC is opened with 8x oversampling. LETIMER is opened with 5-second poll period
- *		and no callbacks.
+ *		ADC is opened with 8x oversampling. Polling is started by battery_start().
+ *
+ * @param[in] poll_cb
+ * 		The event posted every BATTERY_POLLING_PERIOD seconds; its handler must
+ * 		call battery_poll().
  *
  ******************************************************************************/
-void battery_open(void) {
+void battery_open(uint32_t poll_cb) {
 	// open ADC
 	ADC_OPEN_STRUCT_TypeDef adc_init;
 
 	adc_init.em2ClockConfig = adcEm2Disabled;	// only enables async clock when necessary
 	adc_init.ovsRateSel = adcOvsRateSel8;			// pretty arbitrary selection here. we don't need a lot of precision.
-	adc_init.tailgate = false;						// tailgating is only necessary when the ADC is running continuously. we're going to poll it with the LETIMER
+	adc_init.tailgate = false;						// tailgating is only necessary when the ADC is running continuously. we're going to poll it with a software timer
 	adc_init.target_freq = ADC_TARGET_FREQ;
 	adc_init.warmUpMode = adcWarmupNormal;			// shut down ADC when not in use
 	adc_init.channel = ADC_INPUT_BUS;
@@ -53,25 +59,19 @@ void battery_open(void) {
 
 	adc_open(BATTERY_ADC, &adc_init);
 
-	// open LETIMER to poll ADC
-	APP_LETIMER_PWM_TypeDef letimer_init;
-
-	letimer_init.active_period = BATTERY_POLLING_PERIOD / 2;
-	letimer_init.comp0_cb = 0;						// not using callbacks
-	letimer_init.comp0_irq_enable = false;
-	letimer_init.comp1_cb = 0;
-	letimer_init.comp1_irq_enable = false;
-	letimer_init.debugRun = false;
-	letimer_init.enable = false;
-	letimer_init.out_pin_0_en = false;
-	letimer_init.out_pin_1_en = false;
-	letimer_init.out_pin_route0 = PWM_ROUTE_0;
-	letimer_init.out_pin_route1 = PWM_ROUTE_1;
-	letimer_init.period = BATTERY_POLLING_PERIOD;	// 5 seconds
-	letimer_init.uf_cb = 0;
-	letimer_init.uf_irq_enable = true;
-
-	letimer_pwm_open(BATTERY_LETIMER, &letimer_init);
+	poll_event = poll_cb;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Starts polling the battery every BATTERY_POLLING_PERIOD seconds.
+ *
+ * @note
+ *		swtimer_open() must have been called.
+ *
+ ******************************************************************************/
+void battery_start(void) {
+	swtimer_start(&poll_timer, BATTERY_POLLING_PERIOD * 1000u, BATTERY_POLLING_PERIOD * 1000u, poll_event, 0);
 }
 
 /***************************************************************************//**
@@ -84,7 +84,7 @@ void battery_open(void) {
  *		for any high read.
  *
  ******************************************************************************/
-void battery_poll() {
+void battery_poll(void) {
 	adc_start_conversion(BATTERY_ADC);
 
 	uint32_t last_read = adc_get_last_read();
@@ -122,36 +122,23 @@ bool battery_check_low() {
  *
  * @details
  *		Extremely rough estimate - simply a linear percent value between the
- *		battery's dead voltage and full charge.
+ *		battery's dead voltage and full charge. ADC counts are scaled against the
+ *		same 5V reference used by BATTERY_LOW_THRESH.
  *
  * @return
- *		A percent value
+ *		The battery level in hundredths of a percent, from 0 to 10000.
  *
  ******************************************************************************/
-float battery_get_percent() {
-
-	// Calculate the battery percentage
-	float battery_max = BATTERY_MAX_V * 4095;
-	float battery_min = BATTERY_MIN_V * 4095;
-	float percent = 100 * ((float) adc_get_last_read() - (battery_min)) / (battery_max - battery_min);
-
-	// Return 100 if the battery is reading >100, else return the percentage
-	return fmin(percent, 100);
-}
-
-/***************************************************************************//**
- * @brief
- *		LETIMER interrupt handler.
- *
- * @details
- *		Begins the battery reading sequence.
- *
- ******************************************************************************/
-void LETIMER0_IRQHandler(void) {
-	uint32_t int_flag = LETIMER0->IF & LETIMER0->IEN;
-	LETIMER0->IFC = int_flag;
+uint32_t battery_get_percent_centi(void) {
+	uint32_t last_read = adc_get_last_read();
 
-	if (int_flag & LETIMER_IF_UF) {
-		battery_poll();
+	// Clamp to the dead and full charge voltages
+	if (last_read <= BATTERY_MIN_COUNT) {
+		return 0;
 	}
+	if (last_read >= BATTERY_MAX_COUNT) {
+		return 10000;
+	}
+
+	return (10000 * (last_read - BATTERY_MIN_COUNT)) / (BATTERY_MAX_COUNT - BATTERY_MIN_COUNT);
 }
@@ -41,121 +41,73 @@ static int16_t		dig_P7;
 static int16_t		dig_P8;
 static int16_t		dig_P9;
 
-static union {
-	uint32_t u32;
-	signed short s16;
-} u32_s16;
-
-static uint32_t temp_cb, pressure_cb;
-static uint32_t temp, pressure;
+static uint32_t read_cb, cb_data;
+static uint8_t data[BMP280_DATA_LEN];		// Last burst: pressure then temperature, MSB first
+static I2C_Status status;					// Result of the last burst
 
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 void bmp280_read_compensation_values();
 BMP280_S32_t bmp280_compensate_T_int32(BMP280_S32_t adc_T);
+BMP280_U32_t bmp280_compensate_P_int64(BMP280_S32_t adc_P);
 float bmp280_compensate_P_float(BMP280_S32_t adc_P);
+float bmp280_altitude(float pressure_pa, float temp_c);
 
+/***************************************************************************//**
+ * @brief
+ *		Assembles the little-endian 16-bit value of a register from a burst read
+ *		of the compensation block.
+ *
+ ******************************************************************************/
+static inline uint16_t bmp280_le16(const uint8_t *calib, uint32_t reg) {
+	uint32_t offset = reg - BMP280_T1;
+	return (uint16_t)(calib[offset] | (calib[offset + 1] << 8));
+}
 
 /***************************************************************************//**
  * @brief
- *		Series of I2C reads to obtain factory-programmed compensation values used
- *		in bmp280_compensate_T_int32() and bmp280_compensate_P_float().
+ *		Reads the factory-programmed compensation values used in
+ *		bmp280_compensate_T_int32() and bmp280_compensate_P_float().
  *
  * @details
- *		Only needs to be called once, as the values do not change.
- *
- * @note
- * 		Uses some intentional aliasing via the union u32_s16. This is because the
- * 		I2C driver uses uint32_t, but registers T2, T3, and P2-9 return signed
- * 		shorts. The union allows us to access the same memory location using two
- * 		different types. This is typically ill-advised, but we are certain of the
- * 		format of the data we're accessing in this case.
+ *		Only needs to be called once, as the values do not change. The whole
+ *		block from BMP280_T1 to BMP280_P9 is read in a single burst, since the
+ *		BMP280 advances the register address on each byte read. If the read
+ *		fails, the values are left as they were.
  *
  ******************************************************************************/
 void bmp280_read_compensation_values() {
-
 	I2C_PAYLOAD payload = {
-			.byte_count = 2,
+			.byte_count = BMP280_CALIB_LEN,
 			.cb = 0,
 			.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
-			.mode = R_LSB_First,
+			.mode = R_Bytes,
 			.receiver_address = BMP280_RECEIVER_ADDRESS,
-			.receiver_register = BMP280_T1
+			.receiver_register = BMP280_T1,
+			.status = &status
 	};
+	uint8_t calib[BMP280_CALIB_LEN];
 
-	uint32_t receive;
-
-	// Read T1
-	i2c_start(&payload, &receive);
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_T1 = (unsigned short) receive;
-
-	// Read T2
-	payload.receiver_register = BMP280_T2;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_T2 = u32_s16.s16;
-
-	// Read T3
-	payload.receiver_register = BMP280_T3;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_T3 = u32_s16.s16;
-
-	// Read P1
-	payload.receiver_register = BMP280_P1;
-	i2c_start(&payload, &receive);
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P1 = (unsigned short) receive;
-
-	// Read P2
-	payload.receiver_register = BMP280_P2;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P2 = u32_s16.s16;
-
-	// Read P3
-	payload.receiver_register = BMP280_P3;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P3 = u32_s16.s16;
-
-	// Read P4
-	payload.receiver_register = BMP280_P4;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P4 = u32_s16.s16;
-
-	// Read P5
-	payload.receiver_register = BMP280_P5;
-	i2c_start(&payload, &(u32_s16.u32));
+	i2c_start_bytes(&payload, calib);
 	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P5 = u32_s16.s16;
-
-	// Read P6
-	payload.receiver_register = BMP280_P6;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P6 = u32_s16.s16;
-
-	// Read P7
-	payload.receiver_register = BMP280_P7;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P7 = u32_s16.s16;
-
-	// Read P8
-	payload.receiver_register = BMP280_P8;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P8 = u32_s16.s16;
+	if (status != I2C_Ok) {
+		return;
+	}
 
-	// Read P9
-	payload.receiver_register = BMP280_P9;
-	i2c_start(&payload, &(u32_s16.u32));
-	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
-	dig_P9 = u32_s16.s16;
+	// Each value is 16 bits, least significant byte first
+	dig_T1 = bmp280_le16(calib, BMP280_T1);
+	dig_T2 = (int16_t)bmp280_le16(calib, BMP280_T2);
+	dig_T3 = (int16_t)bmp280_le16(calib, BMP280_T3);
+	dig_P1 = bmp280_le16(calib, BMP280_P1);
+	dig_P2 = (int16_t)bmp280_le16(calib, BMP280_P2);
+	dig_P3 = (int16_t)bmp280_le16(calib, BMP280_P3);
+	dig_P4 = (int16_t)bmp280_le16(calib, BMP280_P4);
+	dig_P5 = (int16_t)bmp280_le16(calib, BMP280_P5);
+	dig_P6 = (int16_t)bmp280_le16(calib, BMP280_P6);
+	dig_P7 = (int16_t)bmp280_le16(calib, BMP280_P7);
+	dig_P8 = (int16_t)bmp280_le16(calib, BMP280_P8);
+	dig_P9 = (int16_t)bmp280_le16(calib, BMP280_P9);
 }
 
 /***************************************************************************//**
@@ -187,17 +139,16 @@ BMP280_S32_t bmp280_compensate_T_int32(BMP280_S32_t adc_T) {
  *		Converts the return value from a BMP280 pressure read to Pascals.
  *
  * @note
- *		Code provided by the BMP280 datasheet. Original return value is divided by
- *		256 to convert from Q24.8 fixed point to IEEE-754 floating point.
+ *		Code provided by the BMP280 datasheet.
  *
- * @param[in] adc_T
- * 		The value returned by the BMP280 after a temperature read.
+ * @param[in] adc_P
+ * 		The value returned by the BMP280 after a pressure read.
  *
  * @return
- * 		The temperature read, in 100ths of a degree Celsius.
+ * 		The pressure read, in Pascals as Q24.8 fixed point.
  *
  ******************************************************************************/
-float bmp280_compensate_P_float(BMP280_S32_t adc_P) {
+BMP280_U32_t bmp280_compensate_P_int64(BMP280_S32_t adc_P) {
 	BMP280_S64_t var1, var2, p;
 	var1 = ((BMP280_S64_t)t_fine) - 128000;
 	var2 = var1 * var1 * (BMP280_S64_t)dig_P6;
@@ -213,9 +164,61 @@ float bmp280_compensate_P_float(BMP280_S32_t adc_P) {
 	var1 = (((BMP280_S64_t)dig_P9) * (p>>13) * (p>>13)) >> 25;
 	var2 = (((BMP280_S64_t)dig_P8) * p) >> 19;
 	p = ((p + var1 + var2) >> 8) + (((BMP280_S64_t)dig_P7)<<4);
+	return (BMP280_U32_t)p;
+}
 
-	float fp = (float)p / 256;
-	return fp;
+/***************************************************************************//**
+ * @brief
+ *		Converts the return value from a BMP280 pressure read to Pascals.
+ *
+ * @note
+ *		Divides the datasheet's Q24.8 result by 256 to convert to IEEE-754
+ *		floating point.
+ *
+ * @param[in] adc_P
+ * 		The value returned by the BMP280 after a pressure read.
+ *
+ * @return
+ * 		The pressure read, in Pascals.
+ *
+ ******************************************************************************/
+float bmp280_compensate_P_float(BMP280_S32_t adc_P) {
+	return (float)bmp280_compensate_P_int64(adc_P) / 256;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Assembles the 20-bit ADC values from the last burst.
+ *
+ * @details
+ *		Each value is MSB, LSB, then the top four bits of XLSB.
+ *
+ ******************************************************************************/
+static void bmp280_get_adc(BMP280_S32_t *adc_T, BMP280_S32_t *adc_P) {
+	*adc_P = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4);
+	*adc_T = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4);
+}
+
+/***************************************************************************//**
+ * @brief
+ * 		Estimates altitude from pressure and temperature.
+ *
+ * @note
+ * 		Implementation of formula from https://keisan.casio.com/exec/system/1224585971
+ * 		SEA_LEVEL_PRESSURE is in hPa, so the pressure is converted to match.
+ *
+ * @param[in] pressure_pa
+ * 		The pressure, in Pascals.
+ *
+ * @param[in] temp_c
+ * 		The temperature, in degrees Celsius.
+ *
+ * @return
+ * 		The altitude estimate in meters.
+ *
+ ******************************************************************************/
+float bmp280_altitude(float pressure_pa, float temp_c) {
+	return ((pow((SEA_LEVEL_PRESSURE / (pressure_pa / 100)), (1/5.257)) - 1) * (temp_c + 273.15)) / 0.0065;
 }
 
 //***********************************************************************************
@@ -227,17 +230,17 @@ float bmp280_compensate_P_float(BMP280_S32_t adc_P) {
  * 		Configures the BMP280 and sets static variables.
  *
  * @details
- * 		Sets BMP280's CTRL_MEAS and CONFIG registers, sets static callback variables,
- * 		and gets BMP280 compensation values.
+ * 		Sets BMP280's CTRL_MEAS and CONFIG registers, sets the static callback
+ * 		variables, and gets BMP280 compensation values.
  *
- * @param[in] temp_callback
- * 		The callback number for temperature reads.
+ * @param[in] callback
+ * 		The callback number for bmp280_read().
  *
- * @param[in] pressure_callback
- * 		The callback number for pressure reads.
+ * @param[in] cb_payload
+ * 		The payload scheduled with the callback.
  *
  ******************************************************************************/
-void bmp280_open(uint32_t temp_callback, uint32_t pressure_callback) {
+void bmp280_open(uint32_t callback, uint32_t cb_payload) {
 	I2C_PAYLOAD config = {
 			.byte_count = 1,
 			.cb = 0,
@@ -257,46 +260,73 @@ void bmp280_open(uint32_t temp_callback, uint32_t pressure_callback) {
 	i2c_start(&config, &command);
 	while(i2c_getBusy(ENVSENSE_I2C_PERIPHERAL));
 
-	temp_cb = temp_callback;
-	pressure_cb = pressure_callback;
+	read_cb = callback;
+	cb_data = cb_payload;
 
 	bmp280_read_compensation_values();
 }
 
 /***************************************************************************//**
  * @brief
- * 		Reads the last BMP280 temperature conversion.
+ * 		Reads the last BMP280 pressure and temperature conversions.
+ *
+ * @details
+ * 		One burst from BMP280_PRESSURE_MSB_REG to BMP280_TEMP_XLSB_REG. The
+ * 		BMP280 locks its data registers for the length of a burst, so both
+ * 		values come from the same measurement. The callback set in
+ * 		bmp280_open() is scheduled once the burst completes, successfully or
+ * 		not; see bmp280_get_status().
+ *
+ * @return
+ * 		False if the bus's queue was full.
  *
  ******************************************************************************/
-void bmp280_read_temp() {
+bool bmp280_read(void) {
 	I2C_PAYLOAD payload = {
-			.byte_count = 3,
-			.cb = temp_cb,
+			.byte_count = BMP280_DATA_LEN,
+			.cb = read_cb,
+			.cb_payload = cb_data,
 			.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
-			.mode = R_MSB_First,
+			.mode = R_Bytes,
 			.receiver_address = BMP280_RECEIVER_ADDRESS,
-			.receiver_register = BMP280_TEMP_MSB_REG
+			.receiver_register = BMP280_PRESSURE_MSB_REG,
+			.status = &status
 	};
 
-	i2c_start(&payload, &temp);
+	return i2c_start_bytes(&payload, data);
 }
 
 /***************************************************************************//**
  * @brief
- *		Reads the last BMP280 pressure conversion.
+ * 		Returns the result of the last burst; the data it left is only valid
+ * 		if this is I2C_Ok.
  *
  ******************************************************************************/
-void bmp280_read_pressure() {
-	I2C_PAYLOAD payload = {
-			.byte_count = 3,
-			.cb = pressure_cb,
-			.i2c_peripheral = ENVSENSE_I2C_PERIPHERAL,
-			.mode = R_MSB_First,
-			.receiver_address = BMP280_RECEIVER_ADDRESS,
-			.receiver_register = BMP280_PRESSURE_MSB_REG
-	};
+I2C_Status bmp280_get_status(void) {
+	return status;
+}
 
-	i2c_start(&payload, &pressure);
+/***************************************************************************//**
+ * @brief
+ * 		Compensates the last burst read by bmp280_read().
+ *
+ * @details
+ * 		Runs the temperature and pressure compensation once each, and derives
+ * 		the altitude from their results.
+ *
+ * @param[out] out
+ * 		The temperature, pressure and altitude.
+ *
+ ******************************************************************************/
+void bmp280_get_sample(BMP280_Sample_TypeDef *out) {
+	BMP280_S32_t adc_T, adc_P;
+	bmp280_get_adc(&adc_T, &adc_P);
+
+	// The temperature sets t_fine, which the pressure compensation uses
+	out->temp_centi_c = bmp280_compensate_T_int32(adc_T);
+	BMP280_U32_t pressure_q24_8 = bmp280_compensate_P_int64(adc_P);
+	out->pressure_pa = (pressure_q24_8 + 128) >> 8;
+	out->altitude_dm = (int32_t)(bmp280_altitude((float)pressure_q24_8 / 256, (float)out->temp_centi_c / 100) * 10);
 }
 
 /***************************************************************************//**
@@ -308,7 +338,9 @@ void bmp280_read_pressure() {
  *
  ******************************************************************************/
 float bmp280_get_last_temp_read(void) {
-	return (float)bmp280_compensate_T_int32(temp) / 100;
+	BMP280_S32_t adc_T, adc_P;
+	bmp280_get_adc(&adc_T, &adc_P);
+	return (float)bmp280_compensate_T_int32(adc_T) / 100;
 }
 
 /***************************************************************************//**
@@ -320,25 +352,24 @@ float bmp280_get_last_temp_read(void) {
  *
  ******************************************************************************/
 float bmp280_get_last_pressure_read(void) {
-	return bmp280_compensate_P_float(pressure);
+	BMP280_S32_t adc_T, adc_P;
+	bmp280_get_adc(&adc_T, &adc_P);
+	bmp280_compensate_T_int32(adc_T);
+	return bmp280_compensate_P_float(adc_P);
 }
 
 /***************************************************************************//**
  * @brief
  * 		Estimates altitude based on pressure and temperature values.
  *
- * @note
- * 		Implementation of formula from https://keisan.casio.com/exec/system/1224585971
- *
  * @return
  * 		The altitude estimate in meters.
  *
  ******************************************************************************/
 float bmp280_get_altitude(void) {
-	float current_pressure = bmp280_compensate_P_float(pressure);
-	float current_temp = (float)bmp280_compensate_T_int32(temp) / 100;
-	float altitude = ((pow((SEA_LEVEL_PRESSURE / current_pressure), (1/5.257)) - 1) * (current_temp + 273.15)) / 0.0065;
-	return altitude;
+	BMP280_Sample_TypeDef sample;
+	bmp280_get_sample(&sample);
+	return (float)sample.altitude_dm / 10;
 }
 
 /***************************************************************************//**
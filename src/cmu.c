@@ -40,7 +40,7 @@
  *
  * @details
  * 	 This function enables the HFPER and CORELE clocks, enables the LFRCO and LFXO oscillators,
- * 	 and routes the ULFRCO to the LFA clock tree.
+ * 	 routes the ULFRCO to the LFA clock tree, and the LFXO to the LFB and LFE clock trees.
  *
  * @note
  *
@@ -58,6 +58,9 @@ void cmu_open(void){
 		CMU_OscillatorEnable(cmuOsc_LFXO, true, true);
 		CMU_ClockSelectSet(cmuClock_LFB, cmuSelect_LFXO);
 
+		// The RTCC sensor time base also runs from the LFXO, on the LFE clock tree
+		CMU_ClockSelectSet(cmuClock_LFE, cmuSelect_LFXO);
+
 		// No requirement to enable the ULFRCO oscillator.  It is always enabled in EM0-4H
 
 		// Route LF clock to LETIMER0 clock tree
@@ -0,0 +1,164 @@
+/**
+ * @file color.c
+ * @author Peter Magro
+ * @date August 11th, 2021
+ * @brief Integer-only color conversions for the LED display.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "color.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	The conversion follows the hexcone formulas from
+ *	https://www.rapidtables.com/convert/color/hsv-to-rgb.html, with every term
+ *	scaled by 255^3 so the whole calculation stays in 32-bit integers:
+ *
+ *		C = S * V * 255
+ *		X = S * V * f			f = position within the 60 degree sector, 0-255
+ *		m = (V * 255 - S * V) * 255
+ *
+ *	Each channel is then (C, X or 0) + m, divided by 255^2 to return to 0-255.
+ */
+#define HUE_SECTOR_WIDTH	255u		// hue * 6 / 255 selects one of six sectors
+#define COLOR_SCALE_DIV		(255u * 255u)
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Assigns the chroma, intermediate and zero terms to the channels for one
+ *		hue sector and writes the scaled result.
+ *
+ ******************************************************************************/
+static inline void hsv_sector_to_grb(uint32_t sector, uint32_t frac, uint32_t sv, uint32_t c, uint32_t m, GRB_TypeDef *ret) {
+	uint32_t rp, gp, bp;
+
+	// X rises through even sectors and falls through odd ones
+	uint32_t x = (sector & 1u) ? sv * (HUE_SECTOR_WIDTH - frac) : sv * frac;
+
+	switch (sector) {
+	case 0:
+		rp = c; gp = x; bp = 0;
+		break;
+	case 1:
+		rp = x; gp = c; bp = 0;
+		break;
+	case 2:
+		rp = 0; gp = c; bp = x;
+		break;
+	case 3:
+		rp = 0; gp = x; bp = c;
+		break;
+	case 4:
+		rp = x; gp = 0; bp = c;
+		break;
+	default:
+		rp = c; gp = 0; bp = x;
+		break;
+	}
+
+	ret->g = (gp + m) / COLOR_SCALE_DIV;
+	ret->r = (rp + m) / COLOR_SCALE_DIV;
+	ret->b = (bp + m) / COLOR_SCALE_DIV;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Converts an HSV value to a GRB value.
+ *
+ * @details
+ *		Integer implementation of the rapidtables hexcone formulas. Results match
+ *		the original double-precision version to within 1 count per channel
+ *		(they are the exactly truncated values, without rounding error). A hue of
+ *		255 wraps to red.
+ *
+ * @param[in] hue
+ * 		The H value from 0 to 255.
+ *
+ * @param[in] saturation
+ *		The S value from 0 to 255.
+ *
+ * @param[in] value
+ * 		The V value from 0 to 255.
+ *
+ * @param[in] ret
+ * 		The GRB_TypeDef variable to write the converted results to.
+ ******************************************************************************/
+void hsv_to_grb(uint8_t hue, uint8_t saturation, uint8_t value, GRB_TypeDef *ret) {
+	uint32_t sv = (uint32_t)saturation * value;
+	uint32_t c = sv * 255;
+	uint32_t m = ((uint32_t)value * 255 - sv) * 255;
+
+	uint32_t h6 = (uint32_t)hue * 6;
+	uint32_t sector = h6 / HUE_SECTOR_WIDTH;
+	uint32_t frac = h6 - sector * HUE_SECTOR_WIDTH;
+
+	hsv_sector_to_grb(sector % 6, frac, sv, c, m, ret);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Fills an array with colors stepping evenly around the hue circle.
+ *
+ * @details
+ *		Batch version of hsv_to_grb() for per-column gradients. Saturation and
+ *		value terms are computed once, and the hue sector is found with at most
+ *		six subtractions, so each entry costs a handful of multiplies and the
+ *		final constant divisions.
+ *
+ * @param[out] ret
+ * 		The array to fill, e.g. one entry per display column.
+ *
+ * @param[in] count
+ * 		The number of entries to fill.
+ *
+ * @param[in] hue_start
+ * 		The hue of the first entry, 8.8 fixed point (0 to HUE_FULL_TURN - 1).
+ *
+ * @param[in] hue_step
+ * 		The hue added per entry, 8.8 fixed point. HUE_FULL_TURN / count spreads
+ * 		one full rainbow over the array.
+ *
+ * @param[in] saturation
+ *		The S value from 0 to 255.
+ *
+ * @param[in] value
+ * 		The V value from 0 to 255.
+ *
+ ******************************************************************************/
+void hsv_gradient(GRB_TypeDef *ret, uint32_t count, uint16_t hue_start, uint16_t hue_step, uint8_t saturation, uint8_t value) {
+	uint32_t sv = (uint32_t)saturation * value;
+	uint32_t c = sv * 255;
+	uint32_t m = ((uint32_t)value * 255 - sv) * 255;
+
+	uint32_t hue = hue_start;
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t h6 = ((hue & (HUE_FULL_TURN - 1)) >> HUE_FRACTION_BITS) * 6;
+		uint32_t sector = 0;
+
+		while (h6 >= HUE_SECTOR_WIDTH) {
+			h6 -= HUE_SECTOR_WIDTH;
+			sector++;
+		}
+
+		hsv_sector_to_grb(sector % 6, h6, sv, c, m, &ret[i]);
+		hue += hue_step;
+	}
+}
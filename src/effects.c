@@ -0,0 +1,385 @@
+/**
+ * @file effects.c
+ * @author Peter Magro
+ * @date August 12th, 2021
+ * @brief Procedural color effects rendered per frame into the display buffer.
+ *
+ * @note Inner loops work on whole words with the packed 8-bit instructions in
+ * 			simd.h: one column of 12 LEDs is 36 bytes, i.e. nine words, and every
+ * 			group of four LEDs lines up with three words. This keeps a full-frame
+ * 			effect well inside the dead-zone time budget.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "effects.h"
+
+#include <stddef.h>
+
+#include "color.h"
+#include "font_data.h"
+#include "simd.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define COLUMN_WORDS			((WS2812B_NUM_LEDS * sizeof(GRB_TypeDef)) / sizeof(uint32_t))
+#define LEDS_PER_GROUP			4u		// Four LEDs = twelve bytes = three words
+#define WORDS_PER_GROUP			3u
+#define LED_GROUPS				(WS2812B_NUM_LEDS / LEDS_PER_GROUP)
+
+#define TEXT_LINE_LEDS			6u		// Bottom line on LEDs 0-5, top line on LEDs 6-11
+
+#define PLASMA_WEIGHT_X			48
+#define PLASMA_WEIGHT_Y			48
+#define PLASMA_WEIGHT_XY		32
+
+#define FIRE_SPARK_MIN			160u
+#define FIRE_COOLING_MASK		0x07070707u
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+// Byte masks for a group of four LEDs, indexed by the group's four mask bits
+static const uint32_t group_mask_lut[16][WORDS_PER_GROUP] = {
+	{ 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00FFFFFF, 0x00000000, 0x00000000 },
+	{ 0xFF000000, 0x0000FFFF, 0x00000000 },
+	{ 0xFFFFFFFF, 0x0000FFFF, 0x00000000 },
+	{ 0x00000000, 0xFFFF0000, 0x000000FF },
+	{ 0x00FFFFFF, 0xFFFF0000, 0x000000FF },
+	{ 0xFF000000, 0xFFFFFFFF, 0x000000FF },
+	{ 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF },
+	{ 0x00000000, 0x00000000, 0xFFFFFF00 },
+	{ 0x00FFFFFF, 0x00000000, 0xFFFFFF00 },
+	{ 0xFF000000, 0x0000FFFF, 0xFFFFFF00 },
+	{ 0xFFFFFFFF, 0x0000FFFF, 0xFFFFFF00 },
+	{ 0x00000000, 0xFFFF0000, 0xFFFFFFFF },
+	{ 0x00FFFFFF, 0xFFFF0000, 0xFFFFFFFF },
+	{ 0xFF000000, 0xFFFFFFFF, 0xFFFFFFFF },
+	{ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF },
+};
+
+// One full sine period, amplitude 127
+static const int8_t sine_table[256] = {
+	   0,    3,    6,    9,   12,   16,   19,   22,   25,   28,   31,   34,   37,   40,   43,   46,
+	  49,   51,   54,   57,   60,   63,   65,   68,   71,   73,   76,   78,   81,   83,   85,   88,
+	  90,   92,   94,   96,   98,  100,  102,  104,  106,  107,  109,  111,  112,  113,  115,  116,
+	 117,  118,  120,  121,  122,  122,  123,  124,  125,  125,  126,  126,  126,  127,  127,  127,
+	 127,  127,  127,  127,  126,  126,  126,  125,  125,  124,  123,  122,  122,  121,  120,  118,
+	 117,  116,  115,  113,  112,  111,  109,  107,  106,  104,  102,  100,   98,   96,   94,   92,
+	  90,   88,   85,   83,   81,   78,   76,   73,   71,   68,   65,   63,   60,   57,   54,   51,
+	  49,   46,   43,   40,   37,   34,   31,   28,   25,   22,   19,   16,   12,    9,    6,    3,
+	   0,   -3,   -6,   -9,  -12,  -16,  -19,  -22,  -25,  -28,  -31,  -34,  -37,  -40,  -43,  -46,
+	 -49,  -51,  -54,  -57,  -60,  -63,  -65,  -68,  -71,  -73,  -76,  -78,  -81,  -83,  -85,  -88,
+	 -90,  -92,  -94,  -96,  -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+	-117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+	-127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+	-117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100,  -98,  -96,  -94,  -92,
+	 -90,  -88,  -85,  -83,  -81,  -78,  -76,  -73,  -71,  -68,  -65,  -63,  -60,  -57,  -54,  -51,
+	 -49,  -46,  -43,  -40,  -37,  -34,  -31,  -28,  -25,  -22,  -19,  -16,  -12,   -9,   -6,   -3,
+};
+
+// Palettes are rebuilt only when the requested brightness changes
+static GRB_TypeDef rainbow_palette[256];
+static uint32_t rainbow_palette_value = UINT32_MAX;
+static GRB_TypeDef fire_palette[256];
+static uint32_t fire_palette_value = UINT32_MAX;
+
+// Fire heat field, one byte per LED, rising from LED 0 to LED 11
+static uint8_t fire_heat[EFFECTS_MAX_COLUMNS][WS2812B_NUM_LEDS] __attribute__((aligned(4)));
+static uint32_t fire_seed = 0x2545F491;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Replicates one color across the three words of a four-LED group.
+ *
+ ******************************************************************************/
+static inline void effects_color_words(GRB_TypeDef color, uint32_t words[WORDS_PER_GROUP]) {
+	uint32_t g = (uint8_t)color.g;
+	uint32_t r = (uint8_t)color.r;
+	uint32_t b = (uint8_t)color.b;
+
+	// Little-endian byte order across LEDs: G R B G | R B G R | B G R B
+	words[0] = g | (r << 8) | (b << 16) | (g << 24);
+	words[1] = r | (b << 8) | (g << 16) | (r << 24);
+	words[2] = b | (g << 8) | (r << 16) | (b << 24);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Writes a nine-word column pattern through the column's LED mask.
+ *
+ ******************************************************************************/
+static inline void effects_store_masked(EFFECTS_Column_TypeDef *column, const uint32_t pattern[COLUMN_WORDS], uint32_t mask_bits) {
+	simd_word_t *out = (simd_word_t *)column;
+
+	for (uint32_t group = 0; group < LED_GROUPS; group++) {
+		const uint32_t *lut = group_mask_lut[(mask_bits >> (group * LEDS_PER_GROUP)) & 0xF];
+		const uint32_t *in = &pattern[group * WORDS_PER_GROUP];
+
+		out[group * WORDS_PER_GROUP]     = in[0] & lut[0];
+		out[group * WORDS_PER_GROUP + 1] = in[1] & lut[1];
+		out[group * WORDS_PER_GROUP + 2] = in[2] & lut[2];
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Maps a byte per LED through a palette into a column, honoring the mask.
+ *
+ ******************************************************************************/
+static inline void effects_store_palette(EFFECTS_Column_TypeDef *column, const uint8_t index[WS2812B_NUM_LEDS], const GRB_TypeDef palette[256], uint32_t mask_bits) {
+	for (uint32_t led = 0; led < WS2812B_NUM_LEDS; led++) {
+		if (mask_bits & (1u << led)) {
+			(*column)[led] = palette[index[led]];
+		} else {
+			(*column)[led].g = 0;
+			(*column)[led].r = 0;
+			(*column)[led].b = 0;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Builds the 256-entry rainbow palette at the given brightness.
+ *
+ ******************************************************************************/
+static void effects_build_rainbow_palette(uint8_t value) {
+	if (rainbow_palette_value != value) {
+		hsv_gradient(rainbow_palette, 256, 0, 1u << HUE_FRACTION_BITS, 255, value);
+		rainbow_palette_value = value;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Builds the black - red - yellow - white fire palette at the given
+ *		brightness.
+ *
+ ******************************************************************************/
+static void effects_build_fire_palette(uint8_t value) {
+	if (fire_palette_value == value) {
+		return;
+	}
+
+	for (uint32_t heat = 0; heat < 256; heat++) {
+		uint32_t r = (heat < 86) ? heat * 3 : 255;
+		uint32_t g = (heat < 86) ? 0 : ((heat < 171) ? (heat - 85) * 3 : 255);
+		uint32_t b = (heat < 171) ? 0 : (heat - 170) * 3;
+
+		fire_palette[heat].g = (g * value) >> 8;
+		fire_palette[heat].r = (r * value) >> 8;
+		fire_palette[heat].b = (b * value) >> 8;
+	}
+	fire_palette_value = value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Xorshift32 pseudo-random generator for the fire effect.
+ *
+ ******************************************************************************/
+static inline uint32_t effects_random(void) {
+	fire_seed ^= fire_seed << 13;
+	fire_seed ^= fire_seed >> 17;
+	fire_seed ^= fire_seed << 5;
+	return fire_seed;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Renders two lines of text into an LED mask.
+ *
+ * @details
+ *		Uses the same layout as pov_update_display(): each line centered in
+ *		font_small, bottom line on LEDs 0-5 and top line on LEDs 6-11. The mask
+ *		only changes when the text does, so it is normally rendered once and
+ *		reused by every frame of an effect.
+ *
+ * @param[out] mask
+ * 		One entry per column.
+ *
+ ******************************************************************************/
+void effects_text_mask(uint16_t *mask, uint32_t num_columns, const TextCell_TypeDef *top, const TextCell_TypeDef *bottom) {
+	char line[TEXTCELL_CAPACITY + 1];
+	uint32_t first;
+	uint32_t x;
+
+	for (uint32_t column = 0; column < num_columns; column++) {
+		mask[column] = 0;
+	}
+
+	x = fontengine_center_line(&font_small, top->text, top->length, num_columns, line, &first);
+	fontengine_render_mask(&font_small, line, mask, num_columns, x, TEXT_LINE_LEDS);
+	x = fontengine_center_line(&font_small, bottom->text, bottom->length, num_columns, line, &first);
+	fontengine_render_mask(&font_small, line, mask, num_columns, x, 0);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Fills the frame with a horizontal rainbow, one hue per column.
+ *
+ * @param[in] hue_start
+ * 		Hue of the first column, 8.8 fixed point. Advance it every frame to
+ * 		scroll the rainbow.
+ *
+ * @param[in] hue_step
+ * 		Hue added per column, 8.8 fixed point.
+ *
+ * @param[in] value
+ * 		Brightness, 0 to 255.
+ *
+ ******************************************************************************/
+void effects_gradient(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint16_t hue_start, uint16_t hue_step, uint8_t value) {
+	GRB_TypeDef colors[EFFECTS_MAX_COLUMNS];
+	uint32_t pattern[COLUMN_WORDS];
+
+	if (num_columns > EFFECTS_MAX_COLUMNS) num_columns = EFFECTS_MAX_COLUMNS;
+	hsv_gradient(colors, num_columns, hue_start, hue_step, 255, value);
+
+	for (uint32_t column = 0; column < num_columns; column++) {
+		effects_color_words(colors[column], pattern);
+		for (uint32_t group = 1; group < LED_GROUPS; group++) {
+			pattern[group * WORDS_PER_GROUP]     = pattern[0];
+			pattern[group * WORDS_PER_GROUP + 1] = pattern[1];
+			pattern[group * WORDS_PER_GROUP + 2] = pattern[2];
+		}
+		effects_store_masked(&columns[column], pattern, mask ? mask[column] : EFFECTS_MASK_ALL);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Colors each LED row with its own hue, so text is striped with a cycling
+ *		rainbow.
+ *
+ * @details
+ *		The striped column is built once and then copied through each column's
+ *		mask, which makes this the cheapest effect per frame.
+ *
+ * @param[in] hue_start
+ * 		Hue of LED 0, 8.8 fixed point. Advance it every frame to cycle colors.
+ *
+ * @param[in] hue_step
+ * 		Hue added per LED row, 8.8 fixed point.
+ *
+ ******************************************************************************/
+void effects_color_cycle(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint16_t hue_start, uint16_t hue_step, uint8_t value) {
+	EFFECTS_Column_TypeDef stripe __attribute__((aligned(4)));
+	uint32_t pattern[COLUMN_WORDS];
+
+	hsv_gradient(stripe, WS2812B_NUM_LEDS, hue_start, hue_step, 255, value);
+
+	const simd_word_t *stripe_words = (const simd_word_t *)stripe;
+	for (uint32_t word = 0; word < COLUMN_WORDS; word++) {
+		pattern[word] = stripe_words[word];
+	}
+
+	if (num_columns > EFFECTS_MAX_COLUMNS) num_columns = EFFECTS_MAX_COLUMNS;
+	for (uint32_t column = 0; column < num_columns; column++) {
+		effects_store_masked(&columns[column], pattern, mask ? mask[column] : EFFECTS_MASK_ALL);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Renders an animated plasma field.
+ *
+ * @details
+ *		Each LED's hue is a weighted sum of three sine waves: along the columns,
+ *		along the LEDs, and diagonally. The two axis terms are computed for a
+ *		pixel with a single dual 16-bit multiply-accumulate (SMLAD), with the
+ *		diagonal term as the accumulator.
+ *
+ * @param[in] phase
+ * 		Animation time; advance by one or more every frame.
+ *
+ ******************************************************************************/
+void effects_plasma(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint32_t phase, uint8_t value) {
+	const uint32_t weights = simd_pack16(PLASMA_WEIGHT_X, PLASMA_WEIGHT_Y);
+	int16_t wave_y[WS2812B_NUM_LEDS];
+	uint8_t hues[WS2812B_NUM_LEDS];
+
+	effects_build_rainbow_palette(value);
+
+	for (uint32_t led = 0; led < WS2812B_NUM_LEDS; led++) {
+		wave_y[led] = sine_table[(led * 16 - phase * 2) & 0xFF];
+	}
+
+	if (num_columns > EFFECTS_MAX_COLUMNS) num_columns = EFFECTS_MAX_COLUMNS;
+	for (uint32_t column = 0; column < num_columns; column++) {
+		int16_t wave_x = sine_table[(column * 4 + phase) & 0xFF];
+
+		for (uint32_t led = 0; led < WS2812B_NUM_LEDS; led++) {
+			int32_t diagonal = sine_table[(column * 3 + led * 8 + phase * 3) & 0xFF] * PLASMA_WEIGHT_XY;
+			int32_t sum = simd_smlad(simd_pack16(wave_x, wave_y[led]), weights, diagonal);
+			hues[led] = (uint8_t)((sum >> 7) + phase);
+		}
+
+		effects_store_palette(&columns[column], hues, rainbow_palette, mask ? mask[column] : EFFECTS_MASK_ALL);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Advances and renders a rising fire simulation.
+ *
+ * @details
+ *		Heat is stored one byte per LED, so a column is three words. Each frame,
+ *		every LED takes the average of the two LEDs below it (UHADD8 on words
+ *		shifted by one and two bytes), is blended a quarter towards the
+ *		neighboring column, and is cooled by a small random amount (UQSUB8). A
+ *		random spark is injected at LED 0. Heat is then mapped through the fire
+ *		palette.
+ *
+ ******************************************************************************/
+void effects_fire(EFFECTS_Column_TypeDef *columns, uint32_t num_columns, const uint16_t *mask, uint8_t value) {
+	uint32_t previous[WORDS_PER_GROUP] = { 0, 0, 0 };
+
+	effects_build_fire_palette(value);
+
+	if (num_columns > EFFECTS_MAX_COLUMNS) num_columns = EFFECTS_MAX_COLUMNS;
+	for (uint32_t column = 0; column < num_columns; column++) {
+		simd_word_t *heat = (simd_word_t *)fire_heat[column];
+		uint32_t h0 = heat[0], h1 = heat[1], h2 = heat[2];
+
+		// Rise: LED n takes the average of LEDs n-1 and n-2
+		uint32_t n0 = simd_uhadd8(h0 << 8, h0 << 16);
+		uint32_t n1 = simd_uhadd8((h1 << 8) | (h0 >> 24), (h1 << 16) | (h0 >> 16));
+		uint32_t n2 = simd_uhadd8((h2 << 8) | (h1 >> 24), (h2 << 16) | (h1 >> 16));
+
+		// Spread: three quarters this column, one quarter the previous one
+		if (column != 0) {
+			n0 = simd_uhadd8(n0, simd_uhadd8(n0, previous[0]));
+			n1 = simd_uhadd8(n1, simd_uhadd8(n1, previous[1]));
+			n2 = simd_uhadd8(n2, simd_uhadd8(n2, previous[2]));
+		}
+
+		// Cool
+		n0 = simd_uqsub8(n0, effects_random() & FIRE_COOLING_MASK);
+		n1 = simd_uqsub8(n1, effects_random() & FIRE_COOLING_MASK);
+		n2 = simd_uqsub8(n2, effects_random() & FIRE_COOLING_MASK);
+
+		// Spark at the base
+		uint32_t spark = FIRE_SPARK_MIN + (effects_random() % (256 - FIRE_SPARK_MIN));
+		n0 = (n0 & 0xFFFFFF00) | spark;
+
+		heat[0] = previous[0] = n0;
+		heat[1] = previous[1] = n1;
+		heat[2] = previous[2] = n2;
+
+		effects_store_palette(&columns[column], fire_heat[column], fire_palette, mask ? mask[column] : EFFECTS_MASK_ALL);
+	}
+}
@@ -0,0 +1,210 @@
+/**
+ * @file font_large.c
+ * @brief Generated by tools/fontgen.py from large.txt. Do not edit.
+ *
+ * @note 12 rows, 5.75 columns per character on average including spacing.
+ */
+
+#include "font_data.h"
+
+static const uint8_t large_widths[FONT_NUM_CHARS] = {
+	3, 1, 3, 7, 5, 6, 6, 1, 3, 3, 5, 5, 2, 4, 2, 5,
+	5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+	7, 6, 6, 6, 6, 5, 5, 6, 6, 3, 5, 6, 5, 7, 6, 6,
+	6, 6, 6, 6, 5, 6, 7, 7, 6, 7, 6, 3, 5, 3, 5, 6,
+	2, 5, 5, 5, 5, 5, 4, 5, 5, 1, 3, 5, 2, 7, 5, 5,
+	5, 5, 4, 5, 4, 5, 5, 7, 5, 5, 5, 4, 1, 4, 6,
+};
+
+static const uint16_t large_offsets[FONT_NUM_CHARS] = {
+	0, 3, 4, 7, 14, 19, 25, 31, 32, 35, 38, 43,
+	48, 50, 54, 56, 61, 66, 69, 74, 79, 84, 89, 94,
+	99, 104, 109, 111, 113, 117, 122, 126, 131, 138, 144, 150,
+	156, 162, 167, 172, 178, 184, 187, 192, 198, 203, 210, 216,
+	222, 228, 234, 240, 246, 251, 257, 264, 271, 277, 284, 290,
+	293, 298, 301, 306, 312, 314, 319, 324, 329, 334, 339, 343,
+	348, 353, 354, 357, 362, 364, 371, 376, 381, 386, 391, 395,
+	400, 404, 409, 414, 421, 426, 431, 436, 440, 441, 445,
+};
+
+static const uint16_t large_columns[] = {
+	0x0000, 0x0000, 0x0000,	// ' '
+	0x0FC8,	// '!'
+	0x0E00, 0x0000, 0x0E00,	// '"'
+	0x0120, 0x0120, 0x07F8, 0x0120, 0x07F8, 0x0120, 0x0120,	// '#'
+	0x0310, 0x0490, 0x0FF8, 0x0490, 0x0460,	// '$'
+	0x0418, 0x0A20, 0x0440, 0x0190, 0x0228, 0x0C10,	// '%'
+	0x0670, 0x0988, 0x0948, 0x0628, 0x0010, 0x0068,	// '&'
+	0x0E00,	// '''
+	0x03E0, 0x0410, 0x0808,	// '('
+	0x0808, 0x0410, 0x03E0,	// ')'
+	0x02A0, 0x01C0, 0x03E0, 0x01C0, 0x02A0,	// '*'
+	0x0080, 0x0080, 0x03E0, 0x0080, 0x0080,	// '+'
+	0x0004, 0x0018,	// ','
+	0x0040, 0x0040, 0x0040, 0x0040,	// '-'
+	0x0018, 0x0018,	// '.'
+	0x0018, 0x0060, 0x0080, 0x0300, 0x0C00,	// '/'
+	0x07F0, 0x0848, 0x0888, 0x0908, 0x07F0,	// '0'
+	0x0408, 0x0FF8, 0x0008,	// '1'
+	0x0418, 0x0828, 0x0848, 0x0888, 0x0708,	// '2'
+	0x0410, 0x0808, 0x0888, 0x0888, 0x0770,	// '3'
+	0x01C0, 0x0240, 0x0440, 0x0FF8, 0x0040,	// '4'
+	0x0F10, 0x0908, 0x0908, 0x0908, 0x08F0,	// '5'
+	0x03F0, 0x0488, 0x0888, 0x0888, 0x0070,	// '6'
+	0x0800, 0x0838, 0x08C0, 0x0900, 0x0E00,	// '7'
+	0x0770, 0x0888, 0x0888, 0x0888, 0x0770,	// '8'
+	0x0700, 0x0888, 0x0888, 0x0890, 0x07E0,	// '9'
+	0x0198, 0x0198,	// ':'
+	0x0194, 0x0198,	// ';'
+	0x0080, 0x0140, 0x0220, 0x0410,	// '<'
+	0x0120, 0x0120, 0x0120, 0x0120, 0x0120,	// '='
+	0x0410, 0x0220, 0x0140, 0x0080,	// '>'
+	0x0400, 0x0800, 0x08C8, 0x0900, 0x0600,	// '?'
+	0x07F0, 0x0808, 0x0988, 0x0A48, 0x0BC8, 0x0848, 0x0790,	// '@'
+	0x03F8, 0x0440, 0x0840, 0x0840, 0x0440, 0x03F8,	// 'A'
+	0x0FF8, 0x0888, 0x0888, 0x0888, 0x0888, 0x0770,	// 'B'
+	0x07F0, 0x0808, 0x0808, 0x0808, 0x0808, 0x0410,	// 'C'
+	0x0FF8, 0x0808, 0x0808, 0x0808, 0x0410, 0x03E0,	// 'D'
+	0x0FF8, 0x0888, 0x0888, 0x0888, 0x0808,	// 'E'
+	0x0FF8, 0x0880, 0x0880, 0x0880, 0x0800,	// 'F'
+	0x07F0, 0x0808, 0x0808, 0x0888, 0x0890, 0x04F8,	// 'G'
+	0x0FF8, 0x0080, 0x0080, 0x0080, 0x0080, 0x0FF8,	// 'H'
+	0x0808, 0x0FF8, 0x0808,	// 'I'
+	0x0030, 0x0008, 0x0808, 0x0FF0, 0x0800,	// 'J'
+	0x0FF8, 0x0080, 0x0140, 0x0220, 0x0410, 0x0808,	// 'K'
+	0x0FF8, 0x0008, 0x0008, 0x0008, 0x0008,	// 'L'
+	0x0FF8, 0x0400, 0x0200, 0x0100, 0x0200, 0x0400, 0x0FF8,	// 'M'
+	0x0FF8, 0x0600, 0x0180, 0x0040, 0x0030, 0x0FF8,	// 'N'
+	0x07F0, 0x0808, 0x0808, 0x0808, 0x0808, 0x07F0,	// 'O'
+	0x0FF8, 0x0880, 0x0880, 0x0880, 0x0880, 0x0700,	// 'P'
+	0x07F0, 0x0808, 0x0808, 0x0828, 0x0810, 0x07E8,	// 'Q'
+	0x0FF8, 0x0880, 0x08C0, 0x08A0, 0x0890, 0x0708,	// 'R'
+	0x0710, 0x0888, 0x0888, 0x0888, 0x0888, 0x0470,	// 'S'
+	0x0800, 0x0800, 0x0FF8, 0x0800, 0x0800,	// 'T'
+	0x0FF0, 0x0008, 0x0008, 0x0008, 0x0008, 0x0FF0,	// 'U'
+	0x0E00, 0x01C0, 0x0030, 0x0008, 0x0030, 0x01C0, 0x0E00,	// 'V'
+	0x0FF8, 0x0010, 0x0020, 0x00C0, 0x0020, 0x0010, 0x0FF8,	// 'W'
+	0x0C18, 0x0360, 0x0080, 0x0080, 0x0360, 0x0C18,	// 'X'
+	0x0C00, 0x0200, 0x0100, 0x00F8, 0x0100, 0x0200, 0x0C00,	// 'Y'
+	0x0818, 0x0828, 0x0848, 0x0888, 0x0908, 0x0E08,	// 'Z'
+	0x0FF8, 0x0808, 0x0808,	// '['
+	0x0C00, 0x0300, 0x0080, 0x0060, 0x0018,	// '\'
+	0x0808, 0x0808, 0x0FF8,	// ']'
+	0x0200, 0x0400, 0x0800, 0x0400, 0x0200,	// '^'
+	0x0004, 0x0004, 0x0004, 0x0004, 0x0004, 0x0004,	// '_'
+	0x0800, 0x0400,	// '`'
+	0x0030, 0x0148, 0x0148, 0x0148, 0x00F8,	// 'a'
+	0x0FF8, 0x0108, 0x0108, 0x0108, 0x00F0,	// 'b'
+	0x00F0, 0x0108, 0x0108, 0x0108, 0x0090,	// 'c'
+	0x00F0, 0x0108, 0x0108, 0x0108, 0x0FF8,	// 'd'
+	0x00F0, 0x0148, 0x0148, 0x0148, 0x00D0,	// 'e'
+	0x0100, 0x07F8, 0x0900, 0x0900,	// 'f'
+	0x00F2, 0x0109, 0x0109, 0x0109, 0x01FE,	// 'g'
+	0x0FF8, 0x0100, 0x0100, 0x0100, 0x00F8,	// 'h'
+	0x05F8,	// 'i'
+	0x0002, 0x0001, 0x05FE,	// 'j'
+	0x0FF8, 0x0040, 0x0040, 0x00A0, 0x0118,	// 'k'
+	0x0FF0, 0x0008,	// 'l'
+	0x01F8, 0x0100, 0x0100, 0x00F8, 0x0100, 0x0100, 0x00F8,	// 'm'
+	0x01F8, 0x0100, 0x0100, 0x0100, 0x00F8,	// 'n'
+	0x00F0, 0x0108, 0x0108, 0x0108, 0x00F0,	// 'o'
+	0x01FF, 0x0108, 0x0108, 0x0108, 0x00F0,	// 'p'
+	0x00F0, 0x0108, 0x0108, 0x0108, 0x01FF,	// 'q'
+	0x01F8, 0x0080, 0x0100, 0x0100,	// 'r'
+	0x0088, 0x0148, 0x0148, 0x0148, 0x0130,	// 's'
+	0x0100, 0x07F0, 0x0108, 0x0108,	// 't'
+	0x01F0, 0x0008, 0x0008, 0x0008, 0x01F8,	// 'u'
+	0x01C0, 0x0030, 0x0008, 0x0030, 0x01C0,	// 'v'
+	0x01F0, 0x0008, 0x0010, 0x0060, 0x0010, 0x0008, 0x01F0,	// 'w'
+	0x0108, 0x0090, 0x0060, 0x0090, 0x0108,	// 'x'
+	0x01F2, 0x0009, 0x0009, 0x0009, 0x01FE,	// 'y'
+	0x0118, 0x0128, 0x0148, 0x0188, 0x0108,	// 'z'
+	0x0080, 0x0770, 0x0808, 0x0808,	// '{'
+	0x0FFF,	// '|'
+	0x0808, 0x0808, 0x0770, 0x0080,	// '}'
+	0x0040, 0x0080, 0x0080, 0x0040, 0x0040, 0x0080,	// '~'
+};
+
+static const Font_Kern_TypeDef large_kerning[] = {
+	{ 65, 84, -1 },	// 'A' 'T'
+	{ 70, 44, -1 },	// 'F' ','
+	{ 70, 46, -1 },	// 'F' '.'
+	{ 70, 65, -1 },	// 'F' 'A'
+	{ 70, 74, -1 },	// 'F' 'J'
+	{ 70, 97, -1 },	// 'F' 'a'
+	{ 70, 99, -1 },	// 'F' 'c'
+	{ 70, 100, -1 },	// 'F' 'd'
+	{ 70, 101, -1 },	// 'F' 'e'
+	{ 70, 103, -1 },	// 'F' 'g'
+	{ 70, 111, -1 },	// 'F' 'o'
+	{ 70, 113, -1 },	// 'F' 'q'
+	{ 70, 115, -1 },	// 'F' 's'
+	{ 70, 117, -1 },	// 'F' 'u'
+	{ 70, 121, -1 },	// 'F' 'y'
+	{ 76, 84, -1 },	// 'L' 'T'
+	{ 76, 86, -1 },	// 'L' 'V'
+	{ 76, 89, -1 },	// 'L' 'Y'
+	{ 80, 44, -1 },	// 'P' ','
+	{ 80, 46, -1 },	// 'P' '.'
+	{ 80, 74, -1 },	// 'P' 'J'
+	{ 80, 97, -1 },	// 'P' 'a'
+	{ 84, 44, -1 },	// 'T' ','
+	{ 84, 46, -1 },	// 'T' '.'
+	{ 84, 65, -1 },	// 'T' 'A'
+	{ 84, 74, -1 },	// 'T' 'J'
+	{ 84, 97, -1 },	// 'T' 'a'
+	{ 84, 99, -1 },	// 'T' 'c'
+	{ 84, 100, -1 },	// 'T' 'd'
+	{ 84, 101, -1 },	// 'T' 'e'
+	{ 84, 103, -1 },	// 'T' 'g'
+	{ 84, 111, -1 },	// 'T' 'o'
+	{ 84, 113, -1 },	// 'T' 'q'
+	{ 84, 115, -1 },	// 'T' 's'
+	{ 84, 117, -1 },	// 'T' 'u'
+	{ 84, 121, -1 },	// 'T' 'y'
+	{ 86, 44, -1 },	// 'V' ','
+	{ 86, 46, -1 },	// 'V' '.'
+	{ 86, 74, -1 },	// 'V' 'J'
+	{ 86, 97, -1 },	// 'V' 'a'
+	{ 86, 99, -1 },	// 'V' 'c'
+	{ 86, 100, -1 },	// 'V' 'd'
+	{ 86, 101, -1 },	// 'V' 'e'
+	{ 86, 103, -1 },	// 'V' 'g'
+	{ 86, 111, -1 },	// 'V' 'o'
+	{ 86, 113, -1 },	// 'V' 'q'
+	{ 86, 115, -1 },	// 'V' 's'
+	{ 89, 44, -1 },	// 'Y' ','
+	{ 89, 46, -1 },	// 'Y' '.'
+	{ 89, 74, -1 },	// 'Y' 'J'
+	{ 89, 97, -1 },	// 'Y' 'a'
+	{ 89, 99, -1 },	// 'Y' 'c'
+	{ 89, 100, -1 },	// 'Y' 'd'
+	{ 89, 101, -1 },	// 'Y' 'e'
+	{ 89, 103, -1 },	// 'Y' 'g'
+	{ 89, 111, -1 },	// 'Y' 'o'
+	{ 89, 113, -1 },	// 'Y' 'q'
+	{ 89, 115, -1 },	// 'Y' 's'
+	{ 89, 117, -1 },	// 'Y' 'u'
+	{ 89, 121, -1 },	// 'Y' 'y'
+	{ 102, 44, -1 },	// 'f' ','
+	{ 102, 46, -1 },	// 'f' '.'
+	{ 102, 74, -1 },	// 'f' 'J'
+	{ 102, 97, -1 },	// 'f' 'a'
+	{ 114, 44, -1 },	// 'r' ','
+	{ 114, 46, -1 },	// 'r' '.'
+	{ 114, 74, -1 },	// 'r' 'J'
+	{ 114, 84, -1 },	// 'r' 'T'
+	{ 114, 89, -1 },	// 'r' 'Y'
+	{ 114, 97, -1 },	// 'r' 'a'
+};
+
+const Font_TypeDef font_large = {
+	.height = 12,
+	.spacing = 1,
+	.fallback = '?',
+	.widths = large_widths,
+	.offsets = large_offsets,
+	.columns = large_columns,
+	.kerning = large_kerning,
+	.num_kerning = 70,
+};
@@ -0,0 +1,180 @@
+/**
+ * @file font_small.c
+ * @brief Generated by tools/fontgen.py from small.txt. Do not edit.
+ *
+ * @note 6 rows, 4.91 columns per character on average including spacing.
+ */
+
+#include "font_data.h"
+
+static const uint8_t small_widths[FONT_NUM_CHARS] = {
+	2, 1, 3, 5, 3, 5, 5, 1, 2, 2, 3, 5, 2, 5, 1, 3,
+	4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 2, 5, 5, 5, 5,
+	5, 5, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 4, 5, 5, 5,
+	4, 5, 5, 4, 5, 5, 5, 5, 5, 5, 4, 3, 3, 3, 5, 5,
+	2, 4, 4, 4, 4, 4, 3, 4, 4, 1, 3, 4, 2, 5, 4, 4,
+	4, 4, 4, 4, 3, 4, 5, 5, 4, 4, 4, 4, 1, 4, 5,
+};
+
+static const uint16_t small_offsets[FONT_NUM_CHARS] = {
+	0, 2, 3, 6, 11, 14, 19, 24, 25, 27, 29, 32,
+	37, 39, 44, 45, 48, 52, 56, 60, 64, 68, 72, 76,
+	80, 84, 88, 89, 91, 96, 101, 106, 111, 116, 121, 125,
+	129, 133, 137, 141, 146, 151, 156, 161, 166, 170, 175, 180,
+	185, 189, 194, 199, 203, 208, 213, 218, 223, 228, 233, 237,
+	240, 243, 246, 251, 256, 258, 262, 266, 270, 274, 278, 281,
+	285, 289, 290, 293, 297, 299, 304, 308, 312, 316, 320, 324,
+	328, 331, 335, 340, 345, 349, 353, 357, 361, 362, 366,
+};
+
+static const uint16_t small_columns[] = {
+	0x0000, 0x0000,	// ' '
+	0x003D,	// '!'
+	0x0030, 0x0000, 0x0030,	// '"'
+	0x000A, 0x003F, 0x0024, 0x003F, 0x0014,	// '#'
+	0x001A, 0x0033, 0x0016,	// '$'
+	0x0011, 0x0002, 0x000C, 0x0010, 0x0022,	// '%'
+	0x0002, 0x0015, 0x002D, 0x0012, 0x0005,	// '&'
+	0x0030,	// '''
+	0x001E, 0x0021,	// '('
+	0x0021, 0x001E,	// ')'
+	0x0028, 0x0010, 0x0028,	// '*'
+	0x0004, 0x0004, 0x001F, 0x0004, 0x0004,	// '+'
+	0x0001, 0x0002,	// ','
+	0x0004, 0x0004, 0x0004, 0x0004, 0x0004,	// '-'
+	0x0001,	// '.'
+	0x0003, 0x000C, 0x0030,	// '/'
+	0x001E, 0x0021, 0x0021, 0x001E,	// '0'
+	0x0000, 0x0011, 0x003F, 0x0001,	// '1'
+	0x0011, 0x0023, 0x0025, 0x0019,	// '2'
+	0x0021, 0x0029, 0x0029, 0x0016,	// '3'
+	0x0038, 0x0008, 0x0008, 0x003F,	// '4'
+	0x0039, 0x0029, 0x0029, 0x0026,	// '5'
+	0x001E, 0x0029, 0x0029, 0x0006,	// '6'
+	0x0020, 0x0027, 0x0028, 0x0030,	// '7'
+	0x0016, 0x0029, 0x0029, 0x0016,	// '8'
+	0x0018, 0x0025, 0x0025, 0x001E,	// '9'
+	0x0012,	// ':'
+	0x0001, 0x0012,	// ';'
+	0x0004, 0x000A, 0x000A, 0x0011, 0x0011,	// '<'
+	0x0012, 0x0012, 0x0012, 0x0012, 0x0012,	// '='
+	0x0011, 0x0011, 0x000A, 0x000A, 0x0004,	// '>'
+	0x0010, 0x0020, 0x0025, 0x0028, 0x0010,	// '?'
+	0x0010, 0x0026, 0x0027, 0x0021, 0x001E,	// '@'
+	0x001F, 0x0028, 0x0028, 0x0028, 0x001F,	// 'A'
+	0x003F, 0x0029, 0x0029, 0x0016,	// 'B'
+	0x001E, 0x0021, 0x0021, 0x0021,	// 'C'
+	0x003F, 0x0021, 0x0021, 0x001E,	// 'D'
+	0x003F, 0x0029, 0x0029, 0x0021,	// 'E'
+	0x003F, 0x0028, 0x0028, 0x0020,	// 'F'
+	0x001E, 0x0021, 0x0025, 0x0025, 0x0017,	// 'G'
+	0x003F, 0x0008, 0x0008, 0x0008, 0x003F,	// 'H'
+	0x0021, 0x0021, 0x003F, 0x0020, 0x0021,	// 'I'
+	0x0022, 0x0021, 0x0021, 0x003E, 0x0020,	// 'J'
+	0x003F, 0x0008, 0x0008, 0x0014, 0x0023,	// 'K'
+	0x003F, 0x0001, 0x0001, 0x0001,	// 'L'
+	0x003F, 0x0010, 0x0008, 0x0010, 0x003F,	// 'M'
+	0x003F, 0x0010, 0x0008, 0x0004, 0x003F,	// 'N'
+	0x001E, 0x0021, 0x0021, 0x0021, 0x001E,	// 'O'
+	0x003F, 0x0024, 0x0024, 0x0018,	// 'P'
+	0x001E, 0x0021, 0x0021, 0x0022, 0x001D,	// 'Q'
+	0x003F, 0x0024, 0x0024, 0x0024, 0x001B,	// 'R'
+	0x0011, 0x0029, 0x0029, 0x0026,	// 'S'
+	0x0020, 0x0020, 0x003F, 0x0020, 0x0020,	// 'T'
+	0x003E, 0x0001, 0x0001, 0x0001, 0x003E,	// 'U'
+	0x0038, 0x0006, 0x0001, 0x0006, 0x0038,	// 'V'
+	0x003F, 0x0002, 0x0004, 0x0002, 0x003F,	// 'W'
+	0x0023, 0x0014, 0x0008, 0x0014, 0x0023,	// 'X'
+	0x0030, 0x0008, 0x0007, 0x0008, 0x0030,	// 'Y'
+	0x0023, 0x0025, 0x0029, 0x0031,	// 'Z'
+	0x003F, 0x0021, 0x0021,	// '['
+	0x0030, 0x000C, 0x0003,	// '\'
+	0x0021, 0x0021, 0x003F,	// ']'
+	0x0008, 0x0010, 0x0020, 0x0010, 0x0008,	// '^'
+	0x0001, 0x0001, 0x0001, 0x0001, 0x0001,	// '_'
+	0x0020, 0x0010,	// '`'
+	0x0002, 0x0015, 0x0015, 0x000F,	// 'a'
+	0x003F, 0x0009, 0x0009, 0x0006,	// 'b'
+	0x0006, 0x0009, 0x0009, 0x0009,	// 'c'
+	0x0006, 0x0009, 0x0009, 0x003F,	// 'd'
+	0x000E, 0x0015, 0x0015, 0x000D,	// 'e'
+	0x001F, 0x0024, 0x0010,	// 'f'
+	0x0008, 0x0015, 0x0015, 0x001E,	// 'g'
+	0x003F, 0x0008, 0x0008, 0x0007,	// 'h'
+	0x0017,	// 'i'
+	0x0002, 0x0001, 0x002E,	// 'j'
+	0x003F, 0x0004, 0x0004, 0x000B,	// 'k'
+	0x003E, 0x0001,	// 'l'
+	0x001F, 0x0010, 0x000C, 0x0020, 0x000F,	// 'm'
+	0x000F, 0x0008, 0x0008, 0x0007,	// 'n'
+	0x0006, 0x0009, 0x0009, 0x0006,	// 'o'
+	0x001F, 0x0014, 0x0014, 0x0008,	// 'p'
+	0x0008, 0x0014, 0x0014, 0x001F,	// 'q'
+	0x000F, 0x0004, 0x0008, 0x0008,	// 'r'
+	0x0009, 0x0015, 0x0015, 0x0012,	// 's'
+	0x0008, 0x003E, 0x0009,	// 't'
+	0x000E, 0x0001, 0x0001, 0x000F,	// 'u'
+	0x001C, 0x0002, 0x0001, 0x0002, 0x001C,	// 'v'
+	0x001E, 0x0001, 0x0006, 0x0001, 0x001E,	// 'w'
+	0x0009, 0x0006, 0x0006, 0x0009,	// 'x'
+	0x0018, 0x0005, 0x0005, 0x001E,	// 'y'
+	0x0009, 0x000B, 0x000D, 0x0009,	// 'z'
+	0x0008, 0x0016, 0x0021, 0x0021,	// '{'
+	0x003F,	// '|'
+	0x0021, 0x0021, 0x0016, 0x0008,	// '}'
+	0x000C, 0x0008, 0x0004, 0x0002, 0x0006,	// '~'
+};
+
+static const Font_Kern_TypeDef small_kerning[] = {
+	{ 70, 44, -1 },	// 'F' ','
+	{ 70, 46, -1 },	// 'F' '.'
+	{ 70, 97, -1 },	// 'F' 'a'
+	{ 70, 99, -1 },	// 'F' 'c'
+	{ 70, 100, -1 },	// 'F' 'd'
+	{ 70, 101, -1 },	// 'F' 'e'
+	{ 70, 103, -1 },	// 'F' 'g'
+	{ 70, 111, -1 },	// 'F' 'o'
+	{ 70, 113, -1 },	// 'F' 'q'
+	{ 70, 115, -1 },	// 'F' 's'
+	{ 76, 84, -1 },	// 'L' 'T'
+	{ 76, 86, -1 },	// 'L' 'V'
+	{ 76, 89, -1 },	// 'L' 'Y'
+	{ 76, 103, -1 },	// 'L' 'g'
+	{ 76, 113, -1 },	// 'L' 'q'
+	{ 76, 121, -1 },	// 'L' 'y'
+	{ 80, 44, -1 },	// 'P' ','
+	{ 80, 46, -1 },	// 'P' '.'
+	{ 84, 44, -1 },	// 'T' ','
+	{ 84, 46, -1 },	// 'T' '.'
+	{ 84, 97, -1 },	// 'T' 'a'
+	{ 84, 99, -1 },	// 'T' 'c'
+	{ 84, 100, -1 },	// 'T' 'd'
+	{ 84, 101, -1 },	// 'T' 'e'
+	{ 84, 103, -1 },	// 'T' 'g'
+	{ 84, 111, -1 },	// 'T' 'o'
+	{ 84, 113, -1 },	// 'T' 'q'
+	{ 84, 115, -1 },	// 'T' 's'
+	{ 86, 44, -1 },	// 'V' ','
+	{ 86, 46, -1 },	// 'V' '.'
+	{ 89, 44, -1 },	// 'Y' ','
+	{ 89, 46, -1 },	// 'Y' '.'
+	{ 89, 100, -1 },	// 'Y' 'd'
+	{ 102, 44, -1 },	// 'f' ','
+	{ 102, 46, -1 },	// 'f' '.'
+	{ 102, 100, -1 },	// 'f' 'd'
+	{ 114, 44, -1 },	// 'r' ','
+	{ 114, 46, -1 },	// 'r' '.'
+	{ 114, 74, -1 },	// 'r' 'J'
+	{ 114, 84, -1 },	// 'r' 'T'
+};
+
+const Font_TypeDef font_small = {
+	.height = 6,
+	.spacing = 1,
+	.fallback = '?',
+	.widths = small_widths,
+	.offsets = small_offsets,
+	.columns = small_columns,
+	.kerning = small_kerning,
+	.num_kerning = 40,
+};
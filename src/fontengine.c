@@ -0,0 +1,323 @@
+/**
+ * @file fontengine.c
+ * @author Peter Magro
+ * @date August 16th, 2021
+ * @brief Draws text in proportional fonts, with per-glyph widths and kerning.
+ *
+ * @note Font data is generated from the sources in fonts/ by tools/fontgen.py.
+ * 			Glyph columns are bottom-up bitmasks, the same layout as a display column,
+ * 			so drawing is a shift and OR per column.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "fontengine.h"
+
+#include <string.h>
+
+#include "em_assert.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the glyph index of a character, or of the fallback glyph if the
+ *		font has none.
+ *
+ ******************************************************************************/
+static uint32_t fontengine_glyph(const Font_TypeDef *font, char c) {
+	uint8_t code = (uint8_t)c;
+
+	if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR) {
+		code = (uint8_t)font->fallback;
+	}
+	return code - FONT_FIRST_CHAR;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the blank columns between two adjacent characters.
+ *
+ ******************************************************************************/
+static uint32_t fontengine_gap(const Font_TypeDef *font, char left, char right) {
+	return (uint32_t)((int32_t)font->spacing + fontengine_kerning(font, left, right));
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the kerning adjustment for a pair of characters.
+ *
+ * @details
+ *		Binary search of the font's sorted pair table.
+ *
+ * @return
+ * 		Columns to add to the font's spacing, usually zero or negative.
+ *
+ ******************************************************************************/
+int32_t fontengine_kerning(const Font_TypeDef *font, char left, char right) {
+	uint32_t key = ((uint32_t)(uint8_t)left << 8) | (uint8_t)right;
+	uint32_t low = 0;
+	uint32_t high = font->num_kerning;
+
+	while (low < high) {
+		uint32_t mid = (low + high) / 2;
+		const Font_Kern_TypeDef *pair = &font->kerning[mid];
+		uint32_t pair_key = ((uint32_t)pair->left << 8) | pair->right;
+
+		if (pair_key == key) {
+			return pair->adjust;
+		}
+		if (pair_key < key) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the width of a string in columns, from the left edge of the
+ *		first glyph to the right edge of the last.
+ *
+ ******************************************************************************/
+uint32_t fontengine_text_width(const Font_TypeDef *font, const char *text) {
+	uint32_t width = 0;
+
+	for (; *text; text++) {
+		width += font->widths[fontengine_glyph(font, *text)];
+		if (text[1]) {
+			width += fontengine_gap(font, text[0], text[1]);
+		}
+	}
+	return width;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns how many leading characters of a string fit in a run of
+ *		columns.
+ *
+ ******************************************************************************/
+uint32_t fontengine_fit(const Font_TypeDef *font, const char *text, uint32_t num_columns) {
+	uint32_t x = 0;
+	uint32_t count = 0;
+
+	for (; *text; text++) {
+		x += font->widths[fontengine_glyph(font, *text)];
+		if (x > num_columns) {
+			break;
+		}
+		count++;
+		if (text[1]) {
+			x += fontengine_gap(font, text[0], text[1]);
+		}
+	}
+	return count;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Lays out one line of text centered in a run of columns.
+ *
+ * @details
+ *		Leading and trailing spaces are dropped, since padding a fixed number
+ *		of characters does not align proportional text, and the rest is
+ *		clipped to the whole glyphs that fit.
+ *
+ * @param[in] length
+ * 		Characters of text to lay out; text need not be NUL terminated.
+ *
+ * @param[out] line
+ * 		The characters to draw, NUL terminated; length + 1 bytes.
+ *
+ * @param[out] first
+ * 		Index in text of line[0].
+ *
+ * @return
+ * 		Column of the line's left edge.
+ *
+ ******************************************************************************/
+uint32_t fontengine_center_line(const Font_TypeDef *font, const char *text, uint32_t length, uint32_t num_columns, char *line, uint32_t *first) {
+	uint32_t start = 0;
+	uint32_t end = length;
+
+	while (start < end && text[start] == ' ') {
+		start++;
+	}
+	while (end > start && text[end - 1] == ' ') {
+		end--;
+	}
+
+	memcpy(line, &text[start], end - start);
+	line[end - start] = '\0';
+	line[fontengine_fit(font, line, num_columns)] = '\0';
+
+	*first = start;
+	return (num_columns - fontengine_text_width(font, line)) / 2;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		ORs a string into an LED mask, one bit per LED.
+ *
+ * @details
+ *		Only whole glyphs are drawn; drawing stops at the first glyph that would
+ *		be clipped by the right edge.
+ *
+ * @param[in,out] mask
+ * 		One entry per column; bit n is LED n, counted from the bottom.
+ *
+ * @param[in] x
+ * 		Column of the first glyph's left edge.
+ *
+ * @param[in] y
+ * 		LED of the glyphs' bottom row.
+ *
+ * @return
+ * 		The number of characters drawn.
+ *
+ ******************************************************************************/
+uint32_t fontengine_render_mask(const Font_TypeDef *font, const char *text, uint16_t *mask, uint32_t num_columns, uint32_t x, uint32_t y) {
+	EFM_ASSERT(font->height + y <= FONT_MAX_HEIGHT);
+
+	uint32_t count = 0;
+
+	for (; *text; text++) {
+		uint32_t glyph = fontengine_glyph(font, *text);
+		uint32_t width = font->widths[glyph];
+		if (x + width > num_columns) {
+			break;
+		}
+
+		const uint16_t *columns = &font->columns[font->offsets[glyph]];
+		for (uint32_t i = 0; i < width; i++) {
+			mask[x + i] |= (uint16_t)(columns[i] << y);
+		}
+		x += width;
+		count++;
+
+		if (text[1]) {
+			x += fontengine_gap(font, text[0], text[1]);
+		}
+	}
+	return count;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws a string into a frame in one color.
+ *
+ * @details
+ *		Only lit pixels are written, so text can be drawn over a background.
+ *		Glyphs clipped by the right edge of the frame are not drawn.
+ *
+ * @param[in] x
+ * 		Column of the first glyph's left edge.
+ *
+ * @param[in] y
+ * 		LED of the glyphs' bottom row.
+ *
+ * @return
+ * 		The column just past the last glyph drawn.
+ *
+ ******************************************************************************/
+uint32_t fontengine_draw(POV_Frame_TypeDef *frame, const Font_TypeDef *font, const char *text, uint32_t x, uint32_t y, GRB_TypeDef color) {
+	EFM_ASSERT(font->height + y <= WS2812B_NUM_LEDS);
+
+	uint32_t end = x;
+
+	for (; *text; text++) {
+		uint32_t glyph = fontengine_glyph(font, *text);
+		uint32_t width = font->widths[glyph];
+		if (x + width > DISPLAY_NUM_PIXELS_WIDE) {
+			break;
+		}
+
+		const uint16_t *columns = &font->columns[font->offsets[glyph]];
+		for (uint32_t i = 0; i < width; i++) {
+			for (uint32_t row = 0; row < font->height; row++) {
+				if ((columns[i] >> row) & 1u) {
+					(*frame)[x + i][y + row] = color;
+				}
+			}
+		}
+		x += width;
+		end = x;
+
+		if (text[1]) {
+			x += fontengine_gap(font, text[0], text[1]);
+		}
+	}
+	return end;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Starts a column by column walk over a string.
+ *
+ * @details
+ *		The text is not copied and must outlive the cursor.
+ *
+ ******************************************************************************/
+void fontengine_cursor_init(Font_Cursor_TypeDef *cursor, const Font_TypeDef *font, const char *text) {
+	cursor->font = font;
+	cursor->text = text;
+	cursor->glyph_column = 0;
+	cursor->gap = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the next column of the string, spacing columns included.
+ *
+ * @param[out] column
+ * 		The column's glyph bits, bit n = row n from the bottom.
+ *
+ * @return
+ * 		False once the end of the string has been reached.
+ *
+ ******************************************************************************/
+bool fontengine_cursor_next(Font_Cursor_TypeDef *cursor, uint16_t *column) {
+	const Font_TypeDef *font = cursor->font;
+	const char *text = cursor->text;
+
+	if (!*text) {
+		return false;
+	}
+	if (cursor->gap) {
+		cursor->gap--;
+		*column = 0;
+		return true;
+	}
+
+	uint32_t glyph = fontengine_glyph(font, *text);
+	*column = font->columns[font->offsets[glyph] + cursor->glyph_column];
+
+	if (++cursor->glyph_column >= font->widths[glyph]) {
+		cursor->glyph_column = 0;
+		cursor->text++;
+		if (text[1]) {
+			cursor->gap = fontengine_gap(font, text[0], text[1]);
+		}
+	}
+	return true;
+}
@@ -15,6 +15,7 @@
 #include "em_assert.h"
 
 #include "brd_config.h"
+#include "irq.h"
 
 //***********************************************************************************
 // defined files
@@ -62,6 +63,9 @@ void gpio_open(uint32_t gpio_even_callback, uint32_t gpio_odd_callback){
 // SPI pins
 	GPIO_DriveStrengthSet(WS2812B_SPI_MOSI_PORT, WS2812B_SPI_MOSI_DSTRENGTH);
 	GPIO_PinModeSet(WS2812B_SPI_MOSI_PORT, WS2812B_SPI_MOSI_PIN, WS2812B_SPI_MOSI_GPIOMODE, WS2812B_SPI_MOSI_DEFAULT);
+	GPIO_PinModeSet(MX25_MISO_PORT, MX25_MISO_PIN, MX25_MISO_GPIOMODE, MX25_MISO_DEFAULT);
+	GPIO_PinModeSet(MX25_CLK_PORT, MX25_CLK_PIN, MX25_CLK_GPIOMODE, MX25_CLK_DEFAULT);
+	GPIO_PinModeSet(MX25_CS_PORT, MX25_CS_PIN, MX25_CS_GPIOMODE, MX25_CS_DEFAULT);
 
 // Hall Effect Sensor
 	GPIO_PinModeSet(HALL_EFFECT_PORT, HALL_EFFECT_PIN, HALL_EFFECT_GPIOMODE, HALL_EFFECT_DEFAULT);
@@ -90,6 +94,8 @@ void gpio_open(uint32_t gpio_even_callback, uint32_t gpio_odd_callback){
 // interrupt configuration
 	gpio_even_irq_cb = gpio_even_callback;
 	gpio_odd_irq_cb = gpio_odd_callback;
+	NVIC_SetPriority(GPIO_EVEN_IRQn, IRQ_PRIORITY_HALL);
+	NVIC_SetPriority(GPIO_ODD_IRQn, IRQ_PRIORITY_HALL);
 	NVIC_EnableIRQ(GPIO_EVEN_IRQn);
 	NVIC_EnableIRQ(GPIO_ODD_IRQn);
 }
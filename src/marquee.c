@@ -0,0 +1,192 @@
+/**
+ * @file marquee.c
+ * @author Peter Magro
+ * @date August 13th, 2021
+ * @brief Scrolls arbitrarily long text across the display in real time.
+ *
+ * @note Text is drawn in a proportional font, centered vertically on the
+ * 			twelve LEDs. Scrolling never re-renders the frame: each step writes
+ * 			one column and moves the ring offset, so the cost per revolution is
+ * 			proportional to the number of columns scrolled.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "marquee.h"
+
+#include <stddef.h>
+
+#include "em_assert.h"
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define MARQUEE_MS_PER_SECOND		1000u
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Renders one source column of the marquee text into a frame column and
+ *		moves to the next source column.
+ *
+ * @details
+ *		Columns are taken from the font cursor in order, so the text is never
+ *		searched. Source columns past the end of the text fall in the gap and
+ *		are blank; the cursor restarts when the source wraps.
+ *
+ * @param[out] column
+ * 		The frame column to render into, or NULL to skip the column.
+ *
+ ******************************************************************************/
+static void marquee_next_column(Marquee_TypeDef *marquee, GRB_TypeDef *column) {
+	uint16_t bits = 0;
+
+	if (!fontengine_cursor_next(&marquee->cursor, &bits)) {
+		bits = 0;
+	}
+
+	if (++marquee->next_column >= marquee->source_columns) {
+		marquee->next_column = 0;
+		fontengine_cursor_init(&marquee->cursor, marquee->font, marquee->text);
+	}
+
+	if (column == NULL) {
+		return;
+	}
+
+	uint32_t lit = (uint32_t)bits << marquee->row;
+	for (uint32_t led = 0; led < WS2812B_NUM_LEDS; led++) {
+		uint32_t on = (lit >> led) & 1u;
+		column[led].g = on * marquee->color.g;
+		column[led].r = on * marquee->color.r;
+		column[led].b = on * marquee->color.b;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Renders the next source column into the slot leaving the left edge, and
+ *		advances the ring by one column.
+ *
+ ******************************************************************************/
+static void marquee_step(Marquee_TypeDef *marquee, POV_Frame_TypeDef *frame) {
+	marquee_next_column(marquee, (*frame)[marquee->offset]);
+
+	if (++marquee->offset >= MARQUEE_RING_COLUMNS) {
+		marquee->offset = 0;
+	}
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Sets up a marquee over a NUL terminated string.
+ *
+ * @details
+ *		The text is not copied. The first call to marquee_update() renders the
+ *		full frame; every later call only renders the columns scrolled in.
+ *
+ * @param[in] font
+ * 		The font to draw in, at most WS2812B_NUM_LEDS rows tall.
+ *
+ * @param[in] text
+ * 		The text to scroll, of any length.
+ *
+ * @param[in] color
+ * 		The color of the text.
+ *
+ * @param[in] columns_per_second
+ * 		The scroll speed. Characters are about six columns wide.
+ *
+ ******************************************************************************/
+void marquee_init(Marquee_TypeDef *marquee, const Font_TypeDef *font, const char *text, GRB_TypeDef color, uint32_t columns_per_second) {
+	EFM_ASSERT(font->height <= WS2812B_NUM_LEDS);
+
+	marquee->font = font;
+	marquee->text = text;
+	marquee->color = color;
+	marquee->columns_per_second = columns_per_second;
+	marquee->row = (WS2812B_NUM_LEDS - font->height) / 2;
+	marquee->source_columns = fontengine_text_width(font, text) + MARQUEE_GAP_COLUMNS;
+	marquee->next_column = 0;
+	fontengine_cursor_init(&marquee->cursor, font, text);
+	marquee->offset = 0;
+	marquee->last_ms = 0;
+	marquee->step_remainder = 0;
+	marquee->filled = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Changes the scroll speed without disturbing the current position.
+ *
+ ******************************************************************************/
+void marquee_set_speed(Marquee_TypeDef *marquee, uint32_t columns_per_second) {
+	marquee->columns_per_second = columns_per_second;
+	marquee->step_remainder = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Scrolls the marquee to the given time.
+ *
+ * @details
+ *		The number of steps is derived from elapsed real time, not from the
+ *		number of calls, so the speed is independent of the rotation rate.
+ *		Fractions of a step are carried to the next call.
+ *
+ * @param[in] frame
+ * 		The ring to scroll. Must not be modified by anything else between
+ * 		calls.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds, e.g. from pov_elapsed_ms().
+ *
+ * @return
+ * 		The ring column to display first.
+ *
+ ******************************************************************************/
+uint32_t marquee_update(Marquee_TypeDef *marquee, POV_Frame_TypeDef *frame, uint32_t now_ms) {
+	if (!marquee->filled) {
+		for (uint32_t i = 0; i < MARQUEE_RING_COLUMNS; i++) {
+			marquee_step(marquee, frame);
+		}
+		marquee->last_ms = now_ms;
+		marquee->filled = true;
+		return marquee->offset;
+	}
+
+	uint32_t elapsed = now_ms - marquee->last_ms;
+	marquee->last_ms = now_ms;
+	if (elapsed > MARQUEE_MAX_CATCHUP_MS) {
+		elapsed = MARQUEE_MAX_CATCHUP_MS;
+	}
+
+	uint32_t budget = elapsed * marquee->columns_per_second + marquee->step_remainder;
+	uint32_t steps = budget / MARQUEE_MS_PER_SECOND;
+	marquee->step_remainder = budget % MARQUEE_MS_PER_SECOND;
+
+	// Columns that would scroll in and straight out again are skipped
+	for (; steps > MARQUEE_RING_COLUMNS; steps--) {
+		marquee_next_column(marquee, NULL);
+	}
+
+	while (steps--) {
+		marquee_step(marquee, frame);
+	}
+
+	return marquee->offset;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file mx25.c
+ * @author Peter Magro
+ * @date August 15th, 2021
+ * @brief Reads the on-board MX25 SPI flash over USART2 with DMA.
+ *
+ * @note USART2 and its TX pin (PK0) are shared with the WS2812B data line, so
+ * 			the flash may only be used while no LED data is being sent. Each
+ * 			transaction turns off the LED driver's AUTOTX and flushes the receive
+ * 			buffer, and releases PK0 to a low GPIO once its command is out, so only
+ * 			the command bytes reach the strip. The USART is left at the WS2812B
+ * 			baud rate, which the flash accepts for normal reads. Call mx25_open()
+ * 			after ws2812b_open().
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "mx25.h"
+
+#include <string.h>
+
+#ifdef MX25_HOST_FILE
+#include <assert.h>
+#include <stdio.h>
+#else
+#include "em_assert.h"
+#include "em_core.h"
+#include "em_gpio.h"
+#include "dmadrv.h"
+
+#include "usart.h"
+#include "HW_delay.h"
+#endif
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define MX25_ERASED_BYTE		0xFF
+
+#ifdef MX25_HOST_FILE
+#define EFM_ASSERT(expr)		assert(expr)
+#endif
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+#ifdef MX25_HOST_FILE
+static FILE *image;
+#else
+static volatile bool busy;
+static uint32_t saved_autotx;
+static unsigned int rx_channel;
+static unsigned int tx_channel;
+static MX25_Callback_TypeDef done_callback;
+static const uint8_t dummy = MX25_DUMMY_BYTE;
+#endif
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+#ifndef MX25_HOST_FILE
+
+/***************************************************************************//**
+ * @brief
+ *		Takes USART2 from the LED driver and selects the flash.
+ *
+ * @details
+ *		AUTOTX would clock filler bytes between the command bytes, and anything
+ *		it received would be read back as address or data bytes, so it is
+ *		turned off and the receive buffer emptied. PK0's GPIO output is set low
+ *		so the LED line idles once mx25_release_mosi() hands it back.
+ *
+ ******************************************************************************/
+static void mx25_select(void) {
+	saved_autotx = MX25_USART->CTRL & USART_CTRL_AUTOTX;
+	MX25_USART->CTRL &= ~USART_CTRL_AUTOTX;
+	while (!(MX25_USART->STATUS & USART_STATUS_TXIDLE));
+	MX25_USART->CMD = USART_CMD_CLEARRX;
+
+	GPIO_PinOutClear(WS2812B_SPI_MOSI_PORT, WS2812B_SPI_MOSI_PIN);
+	GPIO_PinOutClear(MX25_CS_PORT, MX25_CS_PIN);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Holds the LED line low for the rest of a read.
+ *
+ * @details
+ *		The flash ignores MOSI while it sends data, so the dummy bytes need not
+ *		leave the chip. The USART still clocks and receives with the pin off.
+ *		USART_SpiTransfer() returns once its byte is fully shifted out, so the
+ *		command is complete when this is called.
+ *
+ ******************************************************************************/
+static void mx25_release_mosi(void) {
+	MX25_USART->ROUTEPEN &= ~USART_ROUTEPEN_TXPEN;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Deselects the flash and gives USART2 back to the LED driver.
+ *
+ ******************************************************************************/
+static void mx25_deselect(void) {
+	GPIO_PinOutSet(MX25_CS_PORT, MX25_CS_PIN);
+
+	MX25_USART->CMD = USART_CMD_CLEARRX;
+	MX25_USART->ROUTEPEN |= USART_ROUTEPEN_TXPEN;
+	MX25_USART->CTRL |= saved_autotx;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Selects the flash and sends a command with a 24-bit address.
+ *
+ ******************************************************************************/
+static void mx25_command(uint8_t command, uint32_t address) {
+	mx25_select();
+	USART_SpiTransfer(MX25_USART, command);
+	USART_SpiTransfer(MX25_USART, (address >> 16) & 0xFF);
+	USART_SpiTransfer(MX25_USART, (address >> 8) & 0xFF);
+	USART_SpiTransfer(MX25_USART, address & 0xFF);
+	mx25_release_mosi();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Sends a command with no address or data.
+ *
+ * @details
+ *		Polled transactions are short and run in a critical section, so a column
+ *		interrupt cannot send LED data through the USART halfway through.
+ *
+ ******************************************************************************/
+static void mx25_command_only(uint8_t command) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	mx25_select();
+	USART_SpiTransfer(MX25_USART, command);
+	mx25_deselect();
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Deselects the flash, restores the LED setup and releases the DMA
+ *		channels after a transfer.
+ *
+ ******************************************************************************/
+static void mx25_finish(void) {
+	mx25_deselect();
+	DMADRV_FreeChannel(rx_channel);
+	DMADRV_FreeChannel(tx_channel);
+	sleep_unblock_mode(USART_SLEEP_BLOCK_MODE);
+	busy = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		DMA callback for the end of an asynchronous read.
+ *
+ * @details
+ *		The receive channel finishes last, once the final byte has been clocked
+ *		in. The user callback may start the next read.
+ *
+ ******************************************************************************/
+static bool mx25_rx_done(unsigned int channel, unsigned int sequenceNo, void *userParam) {
+	(void)channel;
+	(void)sequenceNo;
+	(void)userParam;
+
+	mx25_finish();
+	if (done_callback) {
+		done_callback();
+	}
+	return true;
+}
+
+#endif
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+#ifndef MX25_HOST_FILE
+
+/***************************************************************************//**
+ * @brief
+ *		Routes the flash's MISO and clock pins and wakes it from deep power
+ *		down.
+ *
+ * @details
+ *		The board's shutdown component puts the flash into deep power down at
+ *		boot. USART2 must already be open from ws2812b_open().
+ *
+ ******************************************************************************/
+void mx25_open(void) {
+	MX25_USART->ROUTELOC0 |= MX25_RX_ROUTE | MX25_CLK_ROUTE;
+	MX25_USART->ROUTEPEN |= USART_ROUTEPEN_RXPEN | USART_ROUTEPEN_CLKPEN;
+
+	mx25_command_only(MX25_CMD_RELEASE_POWER_DOWN);
+	timer_delay(MX25_RELEASE_DELAY_MS);
+
+	busy = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the flash to deep power down.
+ *
+ ******************************************************************************/
+void mx25_close(void) {
+	EFM_ASSERT(!busy);
+
+	mx25_command_only(MX25_CMD_DEEP_POWER_DOWN);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Reads the JEDEC ID: manufacturer, memory type and capacity.
+ *
+ * @return
+ * 		The three ID bytes, manufacturer in bits 23-16 (0xC2 for Macronix).
+ *
+ ******************************************************************************/
+uint32_t mx25_read_id(void) {
+	EFM_ASSERT(!busy);
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	mx25_select();
+	USART_SpiTransfer(MX25_USART, MX25_CMD_READ_ID);
+	mx25_release_mosi();
+	uint32_t id = (uint32_t)USART_SpiTransfer(MX25_USART, dummy) << 16;
+	id |= (uint32_t)USART_SpiTransfer(MX25_USART, dummy) << 8;
+	id |= USART_SpiTransfer(MX25_USART, dummy);
+	mx25_deselect();
+	CORE_EXIT_CRITICAL();
+
+	return id;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Reads from the flash, blocking until done.
+ *
+ * @details
+ *		For small reads such as headers; use mx25_read_async() for bulk data.
+ *		Interrupts are held off for the whole read.
+ *
+ ******************************************************************************/
+void mx25_read(uint32_t address, void *dst, uint32_t length) {
+	EFM_ASSERT(!busy);
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	uint8_t *out = dst;
+	mx25_command(MX25_CMD_READ, address);
+	while (length--) {
+		*out++ = USART_SpiTransfer(MX25_USART, dummy);
+	}
+	mx25_deselect();
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Starts a DMA read from the flash.
+ *
+ * @details
+ *		The command is sent by polling. After that, one DMA channel feeds dummy
+ *		bytes to TXDATA while another drains RXDATA into dst. The device stays
+ *		in EM1 until the read completes or is aborted.
+ *
+ * @param[in] length
+ * 		Bytes to read, at most MX25_MAX_READ_LEN.
+ *
+ * @param[in] callback
+ * 		Called from the DMA interrupt when the read completes, or NULL.
+ *
+ ******************************************************************************/
+void mx25_read_async(uint32_t address, void *dst, uint32_t length, MX25_Callback_TypeDef callback) {
+	EFM_ASSERT(!busy);
+	EFM_ASSERT(length > 0 && length <= MX25_MAX_READ_LEN);
+
+	busy = true;
+	done_callback = callback;
+	sleep_block_mode(USART_SLEEP_BLOCK_MODE);
+
+	Ecode_t rx_code = DMADRV_AllocateChannel(&rx_channel, NULL);
+	Ecode_t tx_code = DMADRV_AllocateChannel(&tx_channel, NULL);
+	EFM_ASSERT(rx_code == ECODE_EMDRV_DMADRV_OK && tx_code == ECODE_EMDRV_DMADRV_OK);
+
+	// The polled command leaves the receive buffer empty for the DMA, and the
+	// LED line held low until mx25_finish()
+	mx25_command(MX25_CMD_READ, address);
+
+	DMADRV_PeripheralMemory(rx_channel, dmadrvPeripheralSignal_USART2_RXDATAV, dst,
+			(void*)&MX25_USART->RXDATA, true, length, dmadrvDataSize1, mx25_rx_done, NULL);
+	DMADRV_MemoryPeripheral(tx_channel, dmadrvPeripheralSignal_USART2_TXBL,
+			(void*)&MX25_USART->TXDATA, (void*)&dummy, false, length, dmadrvDataSize1, NULL, NULL);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Cancels an asynchronous read without calling its callback.
+ *
+ * @details
+ *		The destination holds an unknown part of the data afterwards.
+ *
+ ******************************************************************************/
+void mx25_abort(void) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	if (busy) {
+		DMADRV_StopTransfer(tx_channel);
+		DMADRV_StopTransfer(rx_channel);
+		MX25_USART->CMD = USART_CMD_CLEARTX;
+		mx25_finish();
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns true while an asynchronous read is in progress.
+ *
+ ******************************************************************************/
+bool mx25_busy(void) {
+	return busy;
+}
+
+#else
+
+/***************************************************************************//**
+ * @brief
+ *		Opens the file that stands in for the flash contents.
+ *
+ * @return
+ * 		True if the file could be opened.
+ *
+ ******************************************************************************/
+bool mx25_host_open(const char *path) {
+	if (image) {
+		fclose(image);
+	}
+	image = fopen(path, "rb");
+	return image != NULL;
+}
+
+void mx25_open(void) {
+}
+
+void mx25_close(void) {
+}
+
+uint32_t mx25_read_id(void) {
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Reads from the image file. Bytes past its end read as erased flash.
+ *
+ ******************************************************************************/
+void mx25_read(uint32_t address, void *dst, uint32_t length) {
+	size_t got = 0;
+
+	if (image && fseek(image, address, SEEK_SET) == 0) {
+		got = fread(dst, 1, length, image);
+	}
+	memset((uint8_t *)dst + got, MX25_ERASED_BYTE, length - got);
+}
+
+void mx25_read_async(uint32_t address, void *dst, uint32_t length, MX25_Callback_TypeDef callback) {
+	EFM_ASSERT(length > 0 && length <= MX25_MAX_READ_LEN);
+
+	mx25_read(address, dst, length);
+	if (callback) {
+		callback();
+	}
+}
+
+void mx25_abort(void) {
+}
+
+bool mx25_busy(void) {
+	return false;
+}
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file pagecache.c
+ * @author Peter Magro
+ * @date August 17th, 2021
+ * @brief Keeps recently rendered display pages so that showing them again
+ * 			is a pointer swap.
+ *
+ * @note New pages are always rendered into the least recently used slot,
+ * 			never into the page on display, so a page can be re-rendered while
+ * 			its old version is still being shown without tearing.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "pagecache.h"
+
+#include <stddef.h>
+
+#include "em_assert.h"
+#include "em_core.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define PAGECACHE_NO_SLOT		UINT32_MAX
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+static POV_Frame_TypeDef frames[PAGECACHE_NUM_PAGES] __attribute__((aligned(4)));
+
+static struct {
+	uint32_t page;
+	uint32_t version;
+	uint32_t last_used;					// Value of use_clock at the last lookup or commit
+	bool valid;
+} slots[PAGECACHE_NUM_PAGES];
+
+static uint32_t use_clock;
+static uint32_t rendering_slot;
+static PageCache_Stats_TypeDef stats;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the slot to render a new page into.
+ *
+ * @details
+ *		An empty slot if there is one, otherwise the least recently used. The
+ *		most recently used slot, normally the page on display, is only chosen
+ *		if the cache holds a single page.
+ *
+ ******************************************************************************/
+static uint32_t pagecache_victim(void) {
+	uint32_t victim = 0;
+
+	for (uint32_t i = 0; i < PAGECACHE_NUM_PAGES; i++) {
+		if (!slots[i].valid) {
+			return i;
+		}
+		if (slots[i].last_used - slots[victim].last_used > UINT32_MAX / 2) {
+			victim = i;
+		}
+	}
+	return victim;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Empties the cache.
+ *
+ ******************************************************************************/
+void pagecache_init(void) {
+	for (uint32_t i = 0; i < PAGECACHE_NUM_PAGES; i++) {
+		slots[i].valid = false;
+	}
+	use_clock = 0;
+	rendering_slot = PAGECACHE_NO_SLOT;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Finds a page rendered at the given version.
+ *
+ * @return
+ * 		The rendered frame, or NULL if the page must be rendered.
+ *
+ ******************************************************************************/
+const POV_Frame_TypeDef *pagecache_lookup(uint32_t page, uint32_t version) {
+	const POV_Frame_TypeDef *frame = NULL;
+
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	for (uint32_t i = 0; i < PAGECACHE_NUM_PAGES; i++) {
+		if (slots[i].valid && slots[i].page == page && slots[i].version == version) {
+			slots[i].last_used = ++use_clock;
+			frame = &frames[i];
+			break;
+		}
+	}
+	if (frame) {
+		stats.hits++;
+	} else {
+		stats.misses++;
+	}
+	CORE_EXIT_CRITICAL();
+
+	return frame;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Claims a frame to render a page into.
+ *
+ * @details
+ *		Call after a lookup miss, render into the returned frame, then call
+ *		pagecache_commit(). Only one page may be rendered at a time. Any older
+ *		version of the page stays valid until the commit.
+ *
+ * @return
+ * 		The frame to render into. Its previous contents are undefined.
+ *
+ ******************************************************************************/
+POV_Frame_TypeDef *pagecache_begin(uint32_t page, uint32_t version) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	EFM_ASSERT(rendering_slot == PAGECACHE_NO_SLOT);
+
+	uint32_t slot = pagecache_victim();
+	if (slots[slot].valid && slots[slot].page != page) {
+		stats.evictions++;
+	}
+	slots[slot].valid = false;
+	slots[slot].page = page;
+	slots[slot].version = version;
+	rendering_slot = slot;
+	CORE_EXIT_CRITICAL();
+
+	return &frames[slot];
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Publishes a page rendered after pagecache_begin().
+ *
+ * @details
+ *		Older versions of the same page are dropped.
+ *
+ * @param[in] frame
+ * 		The frame returned by pagecache_begin().
+ *
+ * @return
+ * 		The same frame, ready to show.
+ *
+ ******************************************************************************/
+const POV_Frame_TypeDef *pagecache_commit(POV_Frame_TypeDef *frame) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	uint32_t slot = rendering_slot;
+	EFM_ASSERT(slot != PAGECACHE_NO_SLOT && frame == &frames[slot]);
+
+	for (uint32_t i = 0; i < PAGECACHE_NUM_PAGES; i++) {
+		if (i != slot && slots[i].page == slots[slot].page) {
+			slots[i].valid = false;
+		}
+	}
+	slots[slot].valid = true;
+	slots[slot].last_used = ++use_clock;
+	rendering_slot = PAGECACHE_NO_SLOT;
+	CORE_EXIT_CRITICAL();
+
+	return frame;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the hit, miss and eviction counts.
+ *
+ ******************************************************************************/
+void pagecache_get_stats(PageCache_Stats_TypeDef *out) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	*out = stats;
+	CORE_EXIT_CRITICAL();
+}
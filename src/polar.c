@@ -0,0 +1,341 @@
+/**
+ * @file polar.c
+ * @author Peter Magro
+ * @date August 18th, 2021
+ * @brief Draws arcs, needles, sectors and tick rings directly in the display's
+ * 			native angle/radius layout.
+ *
+ * @note All trigonometry is fixed point: sine from a quarter wave table with
+ * 			linear interpolation, and angle and radius of a point by CORDIC.
+ * 			Shapes that are round about the axis touch only the columns and LEDs
+ * 			they cover; shapes placed off the axis, such as a clock face, are
+ * 			walked in Cartesian space and each point is converted.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "polar.h"
+
+#include <string.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define POLAR_QUARTER_TURN			(POLAR_FULL_TURN / 4)
+#define POLAR_HALF_TURN				(POLAR_FULL_TURN / 2)
+#define POLAR_COLUMN_BITS			8u		// log2(POLAR_BRADS_PER_COLUMN)
+#define POLAR_SIN_STEPS				64u		// Table entries per quarter turn
+#define POLAR_SIN_STEP_BITS			8u		// Brads per table step, as a shift
+#define POLAR_CORDIC_STEPS			14u
+#define POLAR_CORDIC_GAIN_INV		39797	// 1/1.64676 in Q16
+#define POLAR_CORDIC_HEADROOM		(1u << 28)	// Leaves room for the CORDIC gain
+#define POLAR_CIRCLE_POINTS			64u
+#define POLAR_LINE_STEP				(POLAR_ONE / 2)		// Half an LED pitch
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+// First quarter of a sine wave, Q15, one entry per 256 brads
+static const int16_t sin_table[POLAR_SIN_STEPS + 1] = {
+	0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+	10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+	18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279,
+	24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268,
+	29621, 29956, 30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137,
+	32285, 32412, 32521, 32609, 32678, 32728, 32757, 32767
+};
+
+// atan(2^-i) in brads
+static const uint16_t cordic_atan[POLAR_CORDIC_STEPS] = {
+	8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1
+};
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the display column of an angle. Angles outside the display
+ *		zone give columns below 0 or past the last column.
+ *
+ ******************************************************************************/
+static int32_t polar_column(polar_angle_t angle) {
+	return ((int32_t)(int16_t)angle + (int32_t)POLAR_ZONE_HALF) >> POLAR_COLUMN_BITS;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the absolute value of a coordinate.
+ *
+ ******************************************************************************/
+static int32_t polar_abs(int32_t value) {
+	return value < 0 ? -value : value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the first and last display column covered by an angle range,
+ *		clipped to the display zone.
+ *
+ * @return
+ * 		False if no column is covered.
+ *
+ ******************************************************************************/
+static bool polar_columns(polar_angle_t start, polar_angle_t end, uint32_t *first, uint32_t *last) {
+	int32_t from = polar_column(start);
+	int32_t to = polar_column(end);
+
+	if (from < 0) from = 0;
+	if (to >= (int32_t)DISPLAY_NUM_PIXELS_WIDE) to = DISPLAY_NUM_PIXELS_WIDE - 1;
+	if (from > to) {
+		return false;
+	}
+	*first = from;
+	*last = to;
+	return true;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the sine of an angle in Q15.
+ *
+ * @details
+ *		Interpolated between 256-brad table steps; the error is below 4 LSB.
+ *
+ ******************************************************************************/
+int32_t polar_sin(polar_angle_t angle) {
+	uint32_t quadrant = angle / POLAR_QUARTER_TURN;
+	uint32_t position = angle % POLAR_QUARTER_TURN;
+
+	if (quadrant & 1u) {
+		position = POLAR_QUARTER_TURN - position;
+	}
+
+	uint32_t index = position >> POLAR_SIN_STEP_BITS;
+	uint32_t fraction = position & ((1u << POLAR_SIN_STEP_BITS) - 1);
+	int32_t value = sin_table[index];
+	if (index < POLAR_SIN_STEPS) {
+		value += ((sin_table[index + 1] - value) * (int32_t)fraction) >> POLAR_SIN_STEP_BITS;
+	}
+
+	return (quadrant & 2u) ? -value : value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the cosine of an angle in Q15.
+ *
+ ******************************************************************************/
+int32_t polar_cos(polar_angle_t angle) {
+	return polar_sin((polar_angle_t)(angle + POLAR_QUARTER_TURN));
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Converts a Cartesian point to polar form by CORDIC.
+ *
+ * @details
+ *		Fourteen shift-and-add steps after scaling the point up to full
+ *		precision; the angle is accurate to a few brads, far finer than a
+ *		display column.
+ *
+ * @param[in] x, y
+ * 		The point, in any consistent unit up to +/-2^29.
+ *
+ * @param[out] radius
+ * 		The distance from the origin, in the unit of x and y. May be NULL.
+ *
+ * @return
+ * 		The angle of the point, measured from +y towards +x.
+ *
+ ******************************************************************************/
+polar_angle_t polar_atan2(int32_t x, int32_t y, uint32_t *radius) {
+	// Rotate the point into the half plane around +y, where CORDIC converges
+	int32_t along = y;
+	int32_t across = x;
+	uint32_t angle = 0;
+
+	if (along < 0) {
+		along = -along;
+		across = -across;
+		angle = POLAR_HALF_TURN;
+	}
+
+	// Scale up so the shifts below keep their precision for short vectors
+	uint32_t largest = (uint32_t)(along | polar_abs(across));
+	if (largest == 0) {
+		if (radius) {
+			*radius = 0;
+		}
+		return 0;
+	}
+	uint32_t scale = 0;
+	if (largest < POLAR_CORDIC_HEADROOM) {
+		scale = __builtin_clz(largest) - __builtin_clz(POLAR_CORDIC_HEADROOM);
+	}
+	along <<= scale;
+	across <<= scale;
+
+	for (uint32_t i = 0; i < POLAR_CORDIC_STEPS; i++) {
+		int32_t next_along;
+		if (across > 0) {
+			next_along = along + (across >> i);
+			across -= along >> i;
+			angle += cordic_atan[i];
+		} else {
+			next_along = along - (across >> i);
+			across += along >> i;
+			angle -= cordic_atan[i];
+		}
+		along = next_along;
+	}
+
+	if (radius) {
+		uint32_t shift = 16 + scale;
+		*radius = (uint32_t)(((int64_t)along * POLAR_CORDIC_GAIN_INV + (1ll << (shift - 1))) >> shift);
+	}
+	return (polar_angle_t)angle;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Converts an angle and radius to a Cartesian offset.
+ *
+ ******************************************************************************/
+void polar_point(polar_angle_t angle, int32_t radius, int32_t *x, int32_t *y) {
+	*x = (radius * polar_sin(angle)) / POLAR_SIN_ONE;
+	*y = (radius * polar_cos(angle)) / POLAR_SIN_ONE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Turns every pixel of a frame off.
+ *
+ ******************************************************************************/
+void polar_clear(POV_Frame_TypeDef *frame) {
+	memset(frame, 0, sizeof(*frame));
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Fills an annular sector: a range of angles across a range of LEDs.
+ *
+ * @param[in] start, end
+ * 		The angle range, inclusive, with start before end. Parts outside the
+ * 		display zone are clipped.
+ *
+ * @param[in] inner_led, outer_led
+ * 		The LED range, inclusive.
+ *
+ ******************************************************************************/
+void polar_sector(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color) {
+	uint32_t first, last;
+
+	if (outer_led >= WS2812B_NUM_LEDS) {
+		outer_led = WS2812B_NUM_LEDS - 1;
+	}
+	if (!polar_columns(start, end, &first, &last)) {
+		return;
+	}
+
+	for (uint32_t column = first; column <= last; column++) {
+		for (uint32_t led = inner_led; led <= outer_led; led++) {
+			(*frame)[column][led] = color;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws an arc of constant radius about the axis.
+ *
+ ******************************************************************************/
+void polar_arc(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, uint32_t led, GRB_TypeDef color) {
+	polar_sector(frame, start, end, led, led, color);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws a radial line, one column wide.
+ *
+ ******************************************************************************/
+void polar_needle(POV_Frame_TypeDef *frame, polar_angle_t angle, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color) {
+	polar_sector(frame, angle, angle, inner_led, outer_led, color);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws a ring of radial ticks at regular angles.
+ *
+ * @param[in] step
+ * 		The angle between ticks; must not be zero.
+ *
+ ******************************************************************************/
+void polar_ticks(POV_Frame_TypeDef *frame, polar_angle_t start, polar_angle_t end, polar_angle_t step, uint32_t inner_led, uint32_t outer_led, GRB_TypeDef color) {
+	int32_t span = (int16_t)(polar_angle_t)(end - start);
+
+	for (int32_t offset = 0; offset <= span; offset += step) {
+		polar_needle(frame, (polar_angle_t)(start + offset), inner_led, outer_led, color);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Lights the pixel nearest to a Cartesian point.
+ *
+ * @param[in] x, y
+ * 		The point, Q8 LED pitches from the axis. Points off the display are
+ * 		ignored.
+ *
+ ******************************************************************************/
+void polar_plot(POV_Frame_TypeDef *frame, int32_t x, int32_t y, GRB_TypeDef color) {
+	uint32_t radius;
+	int32_t column = polar_column(polar_atan2(x, y, &radius));
+	int32_t led = (int32_t)((radius + POLAR_ONE / 2) >> POLAR_FRACTION_BITS) - (int32_t)POLAR_HUB_RADIUS;
+
+	if (column < 0 || column >= (int32_t)DISPLAY_NUM_PIXELS_WIDE
+			|| led < 0 || led >= (int32_t)WS2812B_NUM_LEDS) {
+		return;
+	}
+	(*frame)[column][led] = color;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws a straight line between two Cartesian points.
+ *
+ * @details
+ *		Points are taken every half LED pitch along the line, which leaves no
+ *		gaps at the display's resolution.
+ *
+ ******************************************************************************/
+void polar_line(POV_Frame_TypeDef *frame, int32_t x0, int32_t y0, int32_t x1, int32_t y1, GRB_TypeDef color) {
+	int32_t dx = x1 - x0;
+	int32_t dy = y1 - y0;
+	int32_t length = polar_abs(dx) > polar_abs(dy) ? polar_abs(dx) : polar_abs(dy);
+	int32_t steps = length / POLAR_LINE_STEP + 1;
+
+	for (int32_t i = 0; i <= steps; i++) {
+		polar_plot(frame, x0 + dx * i / steps, y0 + dy * i / steps, color);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws a circle around a Cartesian point.
+ *
+ ******************************************************************************/
+void polar_circle(POV_Frame_TypeDef *frame, int32_t cx, int32_t cy, int32_t radius, GRB_TypeDef color) {
+	for (uint32_t i = 0; i < POLAR_CIRCLE_POINTS; i++) {
+		int32_t x, y;
+		polar_point((polar_angle_t)(i * (POLAR_FULL_TURN / POLAR_CIRCLE_POINTS)), radius, &x, &y);
+		polar_plot(frame, cx + x, cy + y, color);
+	}
+}
@@ -10,91 +10,426 @@
 //***********************************************************************************
 #include "pov.h"
 
-#include <stdio.h>
 #include <string.h>
 
-#include "bmp280.h"
+#include "em_core.h"
+
+#include "scheduler.h"
+
+#include "color.h"
+#include "effects.h"
+#include "font_data.h"
+#include "marquee.h"
+#include "pagecache.h"
+#include "polar.h"
+#include "sensors.h"
+#include "cycles.h"
+#include "sprite_data.h"
+#include "stream.h"
+#include "mx25.h"
 #include "timer.h"
-#include "font.h"
+#include "pov_frames.h"
 #include "battery.h"
-#include "letimer.h"
-#include "math.h"
-#include "si7021.h"
 //***********************************************************************************
 // defined files
 //***********************************************************************************
+#define		EFFECT_BRIGHTNESS			16u		// Same V as Hello World
+#define		EFFECT_HUE_SPEED			(4u << HUE_FRACTION_BITS)	// Hue advance per revolution
+#define		EFFECT_HUE_PER_COLUMN		(HUE_FULL_TURN / DISPLAY_NUM_PIXELS_WIDE)
+#define		EFFECT_HUE_PER_ROW			(HUE_FULL_TURN / WS2812B_NUM_LEDS)
 
+#define		MARQUEE_SPEED				24u		// Columns per second, four characters
+#define		MARQUEE_COLOR				{ 6, 10, 0 }
+
+#define		GAUGE_START					((polar_angle_t)POLAR_DEGREES(-60))
+#define		GAUGE_SPAN					POLAR_DEGREES(120)
+#define		GAUGE_PRESSURE_MIN_HPA		950
+#define		GAUGE_PRESSURE_RANGE_HPA	100
+#define		GAUGE_PRESSURE_TICK_HPA		10
+
+#define		CLOCK_CENTER_Y				((POLAR_HUB_RADIUS + 6) * POLAR_ONE)	// Middle of the LED column
+#define		CLOCK_FACE_RADIUS			(5 * POLAR_ONE)
+#define		CLOCK_MARK_RADIUS			(4 * POLAR_ONE)
+#define		CLOCK_HOUR_HAND				(5 * POLAR_ONE / 2)
+#define		CLOCK_MINUTE_HAND			(4 * POLAR_ONE)
+#define		CLOCK_SECONDS_PER_HALF_DAY	43200u
+
+#define		POV_SENSOR(sensor)			(1u << (sensor))
+
+#define		POV_REFRESH_EVERY_TURN		0u			// Mode is rendered every revolution
+#define		POV_REFRESH_ON_DATA			UINT32_MAX	// Only on entry and when a sensor changes
+
+#define		MENU_GREEN					{ 8, 0, 0 }
+#define		MENU_BLUE					{ 0, 0, 8 }
 
 //***********************************************************************************
 // Static / Private Variables
 //***********************************************************************************
-static uint32_t count_one, count_two;
-static uint32_t ticks_per_deg;
+// Rotation state measured from the hall sensor. Only written at hall priority,
+// by the GPIO and measure timer interrupts, which cannot preempt each other.
+// A new state is written into the buffer not in use and published by advancing
+// rotation_seq, whose low bit selects the live buffer. Readers copy the live
+// buffer and retry if rotation_seq moved meanwhile; a reader that preempts the
+// writer sees the old state, whole, and never has to retry.
+typedef struct {
+	uint32_t count_one, count_two;			// Last two pulse intervals, in measure timer ticks
+	uint32_t ticks_per_deg;
+	uint32_t pulses;						// Hall pulses since pov_open()
+	pov_position half;						// dead_one if a sweep follows the last pulse, else measure
+	bool spinning;							// False until a pulse, and again after the measure timer overflows
+} POV_Rotation_TypeDef;
+
+static POV_Rotation_TypeDef rotation[2];
+static volatile uint32_t rotation_seq;
 
 static enum {
 	count_select_one,
 	count_select_two
 } count_select;
 
-static pov_position current_position;
-static GRB_TypeDef display_buffer[DISPLAY_NUM_PIXELS_WIDE][WS2812B_NUM_LEDS];
+// Sweep state, only written by the column interrupt. It keeps the timing of the
+// pulse it follows for the whole sweep.
+static volatile pov_position current_position;
+static volatile uint32_t sweep_pulses;		// rotation.pulses the sweep follows
+static uint32_t sweep_ticks_per_deg;
+static POV_Frame_TypeDef display_buffers[2] __attribute__((aligned(4)));	// Word access in effects.c
+static const POV_Frame_TypeDef * volatile active_frame;
+static volatile uint32_t frame_offset;		// Column of active_frame shown first
+static const POV_Frame_TypeDef * volatile next_frame;	// Published mid-sweep; shown from the next sweep
+static volatile uint32_t next_offset;
+static POV_Frame_TypeDef *last_render;		// Display buffer holding the latest render
 static volatile uint32_t buffer_index;
 static POV_DisplayMode_TypeDef displaymode;
 
-static float temperature;
-static float humidity;
+// Latest samples of the sensors the current mode subscribes to, copied from the
+// sensor service once per revolution. Text pages are cached under their
+// sensor's number and version.
+static Sensors_Sample_TypeDef readings[SENSORS_NUM];
+
+// Mode registry: what to draw, when to draw it again, and how the menu shows it
+typedef struct {
+	void (*render)(void);
+	uint32_t refresh_ms;					// POV_REFRESH_EVERY_TURN, POV_REFRESH_ON_DATA or a period
+	uint32_t sensors;						// POV_SENSOR() bits read; a changed reading forces a render
+	uint8_t menu_led;
+	GRB_TypeDef menu_color;
+} POV_Mode_TypeDef;
+
+static volatile bool mode_stale;			// Render on the next revolution regardless
+static uint32_t rendered_ms;
+static uint32_t rendered_versions;
+
+static uint16_t effect_mask[DISPLAY_NUM_PIXELS_WIDE];
+static bool effect_mask_valid;
+static uint32_t effect_phase;
+
+static Marquee_TypeDef marquee;
+static bool marquee_active;
+static const char marquee_text[] = "POV2 persistence of vision display - EFR32MG12 Thunderboard Sense 2 - Keith Graham & Peter Magro";
+
+static Sprite_Player_TypeDef sprite_player;
+static bool sprite_active;
+
+static bool stream_active;
+static bool flash_awake;					// MX25 out of deep power down for the stream
+
+static uint32_t polar_max_cycles;			// Worst gauge or clock render seen
+static uint32_t column_max_latency;			// Worst CC0 match to column interrupt entry
+
+static uint32_t elapsed_ms;
+static uint32_t elapsed_ticks;				// Measure timer ticks not yet counted in elapsed_ms
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
-void pov_core();
-void pov_hello_world(POV_Display_TypeDef *display);
-void pov_temp_humidity_start();
-void pov_credits(POV_Display_TypeDef *display);
-void pov_battery_level(POV_Display_TypeDef *display);
-void pov_bmp280_start(void);
-void pov_filler(POV_Display_TypeDef *display);
-void hsv_to_grb(uint8_t H, uint8_t S, uint8_t V, GRB_TypeDef *ret);
+void pov_hello_world(void);
+void pov_temp_humidity(void);
+void pov_credits(void);
+void pov_battery_level(void);
+void pov_pressure_altitude(void);
+void pov_effect(void);
+void pov_marquee(void);
+void pov_animation(void);
+void pov_stream(void);
+void pov_gauges(void);
+void pov_clock(void);
+void pov_render_display(POV_Frame_TypeDef *frame, const POV_Display_TypeDef *display);
+
+static const POV_Mode_TypeDef modes[POV_NUM_MODES] = {
+	[HelloWorld]		= { pov_hello_world,		POV_REFRESH_EVERY_TURN,	0,								0,	MENU_GREEN },
+	[TempHumidity]		= { pov_temp_humidity,		POV_REFRESH_ON_DATA,	POV_SENSOR(Sensor_SI7021),		1,	MENU_GREEN },
+	[Credits]			= { pov_credits,			POV_REFRESH_ON_DATA,	0,								2,	MENU_GREEN },
+	[BatteryLevel]		= { pov_battery_level,		POV_REFRESH_ON_DATA,	POV_SENSOR(Sensor_Battery),		3,	MENU_GREEN },
+	[PressureAltitude]	= { pov_pressure_altitude,	POV_REFRESH_ON_DATA,	POV_SENSOR(Sensor_BMP280),		4,	MENU_GREEN },
+	[EffectGradient]	= { pov_effect,				POV_REFRESH_EVERY_TURN,	0,								5,	MENU_GREEN },
+	[EffectPlasma]		= { pov_effect,				POV_REFRESH_EVERY_TURN,	0,								6,	MENU_GREEN },
+	[EffectFire]		= { pov_effect,				POV_REFRESH_EVERY_TURN,	0,								7,	MENU_GREEN },
+	[EffectColorCycle]	= { pov_effect,				POV_REFRESH_EVERY_TURN,	0,								8,	MENU_GREEN },
+	[Marquee]			= { pov_marquee,			POV_REFRESH_EVERY_TURN,	0,								9,	MENU_GREEN },
+	[Animation]			= { pov_animation,			POV_REFRESH_EVERY_TURN,	0,								10,	MENU_GREEN },
+	[Stream]			= { pov_stream,				POV_REFRESH_EVERY_TURN,	0,								11,	MENU_GREEN },
+	[Gauges]			= { pov_gauges,				POV_REFRESH_ON_DATA,	POV_SENSOR(Sensor_BMP280) | POV_SENSOR(Sensor_Battery),	0,	MENU_BLUE },
+	[Clock]				= { pov_clock,				250u,					0,								1,	MENU_BLUE },
+};
 
 /***************************************************************************//**
  * @brief
- *		Calls relevant display function depending on current display mode.
+ *		Copies a consistent rotation state, without masking interrupts.
+ *
+ * @details
+ *		Retries only if a pulse was published during the copy, which cannot
+ *		happen when called from the column interrupt.
+ *
+ * @return
+ * 		The rotation_seq the copy belongs to. A caller that reads the measure
+ * 		timer afterwards can compare it with rotation_seq to check that no
+ * 		pulse restarted the timer in between.
  *
  ******************************************************************************/
-void pov_core() {
-	POV_Display_TypeDef display;
+static uint32_t pov_rotation_read(POV_Rotation_TypeDef *out) {
+	uint32_t seq;
+
+	do {
+		seq = rotation_seq;
+		__DMB();
+		*out = rotation[seq & 1u];
+		__DMB();
+	} while (seq != rotation_seq);
+	return seq;
+}
 
-	// Displays "Hello World"
-	switch(displaymode) {
-	case HelloWorld:
-		pov_hello_world(&display);
-		pov_update_display(display);
-		break;
+/***************************************************************************//**
+ * @brief
+ *		Returns the buffer for the next rotation state, holding a copy of the
+ *		current one. Hall priority only.
+ *
+ ******************************************************************************/
+static POV_Rotation_TypeDef *pov_rotation_begin(void) {
+	POV_Rotation_TypeDef *next = &rotation[(rotation_seq + 1u) & 1u];
 
-	// Displays temperature and humidity
-	case TempHumidity:
-		pov_temp_humidity_start();
-		break;
+	*next = rotation[rotation_seq & 1u];
+	return next;
+}
 
-	// Displays "Keith Graham" and "Peter Magro"
-	case Credits:
-		pov_credits(&display);
-		pov_update_display(display);
-		break;
+/***************************************************************************//**
+ * @brief
+ *		Publishes the state filled in after pov_rotation_begin().
+ *
+ ******************************************************************************/
+static void pov_rotation_publish(void) {
+	__DMB();
+	rotation_seq++;
+}
 
-	// Displays the battery level as a percentage
-	case BatteryLevel:
-		pov_battery_level(&display);
-		pov_update_display(display);
-		break;
+/***************************************************************************//**
+ * @brief
+ *		Restarts the sweep from a newly published hall pulse.
+ *
+ * @details
+ *		Column interrupt only. A sweep still showing is ended. If the pulse
+ *		starts the dead zone before a sweep, the tick timer is started with the
+ *		new timing, which the sweep then keeps until it ends.
+ *
+ * @param[in] rot
+ * 		The rotation state holding the pulse.
+ *
+ ******************************************************************************/
+static void pov_follow_pulse(const POV_Rotation_TypeDef *rot) {
+	sweep_pulses = rot->pulses;
 
-	case PressureAltitude:
-		pov_bmp280_start();
-		break;
+	if (current_position == display) {
+		pov_end_display();
+	}
 
-	default:
-		pov_filler(&display);
-		pov_update_display(display);
-		break;
+	if (rot->half == dead_one) {
+		sweep_ticks_per_deg = rot->ticks_per_deg;
+		timer_start(POV_TICK_TIMER, sweep_ticks_per_deg * DEAD_ZONE_WIDTH, UINT32_MAX);
+		current_position = dead_one;
+	} else {
+		timer_stop(POV_TICK_TIMER);
+		current_position = measure;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Copies the latest samples of the subscribed sensors into readings[].
+ *
+ ******************************************************************************/
+static void pov_read_sensors(uint32_t subscriptions) {
+	for (uint32_t sensor = 0; sensor < SENSORS_NUM; sensor++) {
+		if (subscriptions & POV_SENSOR(sensor)) {
+			sensors_get(sensor, &readings[sensor]);
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns a value that changes whenever any of the given sensors has a
+ *		new reading.
+ *
+ ******************************************************************************/
+static uint32_t pov_sensor_versions(uint32_t subscriptions) {
+	uint32_t sum = 0;
+
+	for (uint32_t sensor = 0; sensor < SENSORS_NUM; sensor++) {
+		if (subscriptions & POV_SENSOR(sensor)) {
+			sum += readings[sensor].version;
+		}
+	}
+	return sum;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the display buffer to render the next frame into.
+ *
+ * @details
+ *		Renders run in the main loop and may be late or preempted, so they never
+ *		draw into the frame the sweep is showing. The other buffer is taken; a
+ *		frame published into it that no sweep has started on yet is withdrawn
+ *		first, so the sweep keeps showing a complete frame until
+ *		pov_publish_frame().
+ *
+ * @param[in] keep
+ * 		Copy the latest render into the buffer first, for renders that only
+ * 		update what changed since the last call.
+ *
+ ******************************************************************************/
+static POV_Frame_TypeDef *pov_render_begin(bool keep) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	POV_Frame_TypeDef *target = (active_frame == &display_buffers[0]) ? &display_buffers[1] : &display_buffers[0];
+	if (next_frame == target) {
+		next_frame = NULL;
+	}
+	CORE_EXIT_CRITICAL();
+
+	if (keep && last_render != target) {
+		memcpy(target, last_render, sizeof(*target));
+	}
+	last_render = target;
+	return target;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Makes a complete frame the one to show.
+ *
+ * @details
+ *		Swapped in at once while the LEDs are dark. During a sweep it is held
+ *		back and swapped in by pov_start_display(), so a sweep never changes
+ *		frames partway.
+ *
+ * @param[in] offset
+ * 		The column of the frame to show first.
+ *
+ ******************************************************************************/
+static void pov_publish_frame(const POV_Frame_TypeDef *frame, uint32_t offset) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	if (current_position == display) {
+		next_frame = frame;
+		next_offset = offset;
+	} else {
+		active_frame = frame;
+		frame_offset = offset;
+		next_frame = NULL;
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Shows a sensor's text page if it is already rendered at the current
+ *		reading.
+ *
+ * @details
+ *		Until the sensor's first reading arrives, the filler frame is shown
+ *		instead, which also counts as shown.
+ *
+ * @return
+ * 		True if nothing needs to be rendered.
+ *
+ ******************************************************************************/
+static bool pov_show_cached_page(Sensors_Id_TypeDef sensor) {
+	if (readings[sensor].seq == 0) {
+		pov_show_static_frame(&pov_frame_filler);
+		return true;
+	}
+
+	const POV_Frame_TypeDef *frame = pagecache_lookup(sensor, readings[sensor].version);
+	if (frame) {
+		pov_show_static_frame(frame);
+	}
+	return frame != NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Renders a sensor's text page into the page cache and shows it.
+ *
+ * @details
+ *		The display buffers are not touched, so a marquee or animation in
+ *		progress keeps its state.
+ *
+ ******************************************************************************/
+static void pov_show_page(Sensors_Id_TypeDef sensor, const POV_Display_TypeDef *display) {
+	POV_Frame_TypeDef *frame = pagecache_begin(sensor, readings[sensor].version);
+	pov_render_display(frame, display);
+	pov_show_static_frame(pagecache_commit(frame));
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Renders the current display mode, if it is due.
+ *
+ * @details
+ *		Runs from POV_RENDER_CB, posted at the end of every display zone so
+ *		that rendering happens in the main loop while the LEDs are dark, not
+ *		in the column interrupt. The mode is only rendered
+ *		on entry, when its refresh period has passed, or when the sensor
+ *		service has published a different reading from a sensor it subscribes
+ *		to. Otherwise the frame from the last render is shown again.
+ *
+ ******************************************************************************/
+void pov_core(void) {
+	POV_DisplayMode_TypeDef current = displaymode;
+	const POV_Mode_TypeDef *mode = &modes[current];
+	uint32_t now = pov_elapsed_ms();
+
+	// Leaving the stream mode frees the external flash and its ring, and puts
+	// the flash back into deep power down. Done here rather than in
+	// pov_change_mode() so the flash is only used from the main loop.
+	if (flash_awake && current != Stream) {
+		stream_close();
+		stream_active = false;
+		mx25_close();
+		flash_awake = false;
+	}
+
+	// A low battery overrides every mode with a pre-rendered warning
+	if (battery_check_low()) {
+		pov_show_static_frame(&pov_frame_low_battery);
+		mode_stale = true;
+		return;
+	}
+
+	pov_read_sensors(mode->sensors);
+
+	uint32_t versions = pov_sensor_versions(mode->sensors);
+	bool due = mode_stale || versions != rendered_versions;
+	if (mode->refresh_ms == POV_REFRESH_EVERY_TURN) {
+		due = true;
+	} else if (mode->refresh_ms != POV_REFRESH_ON_DATA && now - rendered_ms >= mode->refresh_ms) {
+		due = true;
+	}
+
+	if (due) {
+		mode_stale = false;
+		rendered_ms = now;
+		rendered_versions = versions;
+		mode->render();
 	}
 }
 
@@ -106,11 +441,9 @@ void pov_core() {
  *		Slowly rotates through the color spectrum, with top and bottom colors
  *		180 degrees apart.
  *
- * @param[in] display
- * 		The display variable to write to.
- *
  ******************************************************************************/
-void pov_hello_world(POV_Display_TypeDef *display) {
+void pov_hello_world(void) {
+	POV_Display_TypeDef display;
 	static uint8_t H;
 	uint8_t S = 255;
 	uint8_t V = 16;
@@ -118,183 +451,471 @@ void pov_hello_world(POV_Display_TypeDef *display) {
 	// Shift hue each call
 	H += 5;
 
-	GRB_TypeDef top_color;
-	GRB_TypeDef bottom_color;
+	// Convert HSV value to GRB: top and bottom are half a turn apart
+	GRB_TypeDef colors[2];
+	hsv_gradient(colors, 2, H << HUE_FRACTION_BITS, HUE_FULL_TURN / 2, S, V);
+
+	textcell_clear(&display.top_text);
+	textcell_clear(&display.bottom_text);
+	textcell_append_str(&display.top_text, "      HELLO     ", 0, TextCell_Left);
+	textcell_append_str(&display.bottom_text, "      WORLD     ", 0, TextCell_Left);
+	for (uint32_t i = 0; i < TEXTCELL_CAPACITY; i++) {
+		display.top_colors[i] = colors[0];
+		display.bottom_colors[i] = colors[1];
+	}
+
+	pov_update_display(display);
+}
 
-	// Convert HSV value to GRB
-	hsv_to_grb(H, S, V, &top_color);
-	hsv_to_grb(H + 128, S, V, &bottom_color);
+/***************************************************************************//**
+ * @brief
+ *		Displays the last temperature and humidity reading.
+ *
+ ******************************************************************************/
+void pov_temp_humidity(void) {
+	if (pov_show_cached_page(Sensor_SI7021)) {
+		return;
+	}
+
+	int32_t humidity = readings[Sensor_SI7021].values[0];
+	int32_t temperature = readings[Sensor_SI7021].values[1];
+
+	/*
+	 * Create temperature and humidity strings, right-aligning the numbers so
+	 * the colored fields below line up: "Humidity: 45.23%" / "Temp:      72.4F"
+	 */
+	POV_Display_TypeDef display;
+
+	textcell_clear(&display.top_text);
+	textcell_append_str(&display.top_text, "Humidity:", 0, TextCell_Left);
+	textcell_append_fixed(&display.top_text, humidity, 2, 6, TextCell_Right);
+	textcell_append_str(&display.top_text, "%", 0, TextCell_Left);
+	textcell_finish(&display.top_text, TextCell_Left);
+
+	textcell_clear(&display.bottom_text);
+	textcell_append_str(&display.bottom_text, "Temp:", 0, TextCell_Left);
+	textcell_append_fixed(&display.bottom_text, temperature, 1, 10, TextCell_Right);
+	textcell_append_str(&display.bottom_text, "F", 0, TextCell_Left);
+	textcell_finish(&display.bottom_text, TextCell_Left);
+
+
+	/* Write colors to display variable */
+	GRB_TypeDef top_text_color = { 2, 2, 4 };
+	GRB_TypeDef top_num_color = { 1, 1, 6};
+	GRB_TypeDef bottom_text_color = { 2, 4, 2 };
+	GRB_TypeDef bottom_num_color = { 1, 6, 1 };
 
-	// Write to return variable
-	display->top_string = "      HELLO     ";
-	display->bottom_string = "      WORLD     ";
-	for (int i = 0; i < 12; i++) {
-		display->top_colors[i] = top_color;
-		display->bottom_colors[i] = bottom_color;
+	for (uint32_t i = 0; i < 9; i++) {
+		display.top_colors[i] = top_text_color;
+	}
+	for (uint32_t i = 9; i < TEXTCELL_CAPACITY; i++) {
+		display.top_colors[i] = top_num_color;
+	}
+	for (uint32_t i = 0; i < 5; i++) {
+		display.bottom_colors[i] = bottom_text_color;
+	}
+	for (uint32_t i = 5; i < TEXTCELL_CAPACITY; i++) {
+		display.bottom_colors[i] = bottom_num_color;
 	}
+
+	pov_show_page(Sensor_SI7021, &display);
 }
 
 /***************************************************************************//**
  * @brief
- *		Begins the SI7021 humidity read sequence. Will result in calls to
- *		pov_update_humidity() and pov_update_si7021_temp().
+ *		Displays the credits.
  *
  ******************************************************************************/
-void pov_temp_humidity_start() {
-	si7021_read(SI7021_RELATIVE_HUMIDITY_NO_HOLD, SI7021_HUMIDITY_CB, R_MSB_First);
+void pov_credits(void) {
+	pov_show_static_frame(&pov_frame_credits);
 }
 
 /***************************************************************************//**
  * @brief
- * 		Displays "Keith Graham" and "Peter Magro" in white and gold.
+ *		Displays the battery level on the POV display.
  *
- * @param[in] display
- * 		The display variable to write to.
+ * @details
+ *		The page is only formatted and rendered when the level changes.
  *
  ******************************************************************************/
-void pov_credits(POV_Display_TypeDef *display) {
-	GRB_TypeDef top_color = { 6, 6, 6 };
-	GRB_TypeDef bottom_color = { 10, 8, 0 };
+void pov_battery_level(void) {
+	if (pov_show_cached_page(Sensor_Battery)) {
+		return;
+	}
+
+	int32_t percent = readings[Sensor_Battery].values[0];
 
-	display->top_string = "  Keith Graham  ";
-	display->bottom_string = "   Peter Magro  ";
+	POV_Display_TypeDef display;
+
+	textcell_clear(&display.top_text);
+	textcell_append_str(&display.top_text, "Battery:", 0, TextCell_Left);
+	textcell_finish(&display.top_text, TextCell_Center);
+
+	textcell_clear(&display.bottom_text);
+	textcell_append_fixed(&display.bottom_text, percent, 2, 0, TextCell_Left);
+	textcell_append_str(&display.bottom_text, "%", 0, TextCell_Left);
+	textcell_finish(&display.bottom_text, TextCell_Center);
 
-	for (uint32_t i = 0; i < DISPLAY_NUM_CHARS; i++) {
-		display->top_colors[i] = top_color;
-		display->bottom_colors[i] = bottom_color;
+	GRB_TypeDef color = { 0, 8, 0 };
+
+	for (uint32_t i = 0; i < TEXTCELL_CAPACITY; i++) {
+		display.top_colors[i] = color;
+		display.bottom_colors[i] = color;
 	}
+
+	pov_show_page(Sensor_Battery, &display);
 }
 
 /***************************************************************************//**
  * @brief
- *		Displays the battery level on the POV display.
+ *		Shows the last pressure and altitude estimate on the display.
  *
- * @note
- * 		Not yet implemented.
+ ******************************************************************************/
+void pov_pressure_altitude(void) {
+	if (pov_show_cached_page(Sensor_BMP280)) {
+		return;
+	}
+
+	int32_t pressure_hpa = readings[Sensor_BMP280].values[0];
+	int32_t altitude = readings[Sensor_BMP280].values[1];
+
+	POV_Display_TypeDef display;
+
+	// "Pressure:1013hPa" / "Altitude: 123.4m"
+	textcell_clear(&display.top_text);
+	textcell_append_str(&display.top_text, "Pressure:", 0, TextCell_Left);
+	textcell_append_fixed(&display.top_text, pressure_hpa, 0, 4, TextCell_Right);
+	textcell_append_str(&display.top_text, "hPa", 0, TextCell_Left);
+	textcell_finish(&display.top_text, TextCell_Left);
+
+	textcell_clear(&display.bottom_text);
+	textcell_append_str(&display.bottom_text, "Altitude:", 0, TextCell_Left);
+	textcell_append_fixed(&display.bottom_text, altitude, 1, 6, TextCell_Right);
+	textcell_append_str(&display.bottom_text, "m", 0, TextCell_Left);
+	textcell_finish(&display.bottom_text, TextCell_Left);
+
+	GRB_TypeDef text_color = { 2, 4, 2 };
+	GRB_TypeDef num_color = { 3, 6, 0 };
+
+	for (uint32_t i = 0; i < 9; i++) {
+		display.top_colors[i] = text_color;
+		display.bottom_colors[i] = text_color;
+	}
+	for (uint32_t i = 9; i < TEXTCELL_CAPACITY; i++) {
+		display.top_colors[i] = num_color;
+		display.bottom_colors[i] = num_color;
+	}
+
+	pov_show_page(Sensor_BMP280, &display);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Renders one frame of a procedural effect behind the "Hello World" text.
  *
- * @param[in]
- * 		The display variable to write to.
+ * @details
+ *		The text mask is rendered once and kept; every revolution after that
+ *		only the effect itself is computed, into the display buffer not on show.
+ *		The effect is chosen by the current display mode.
  *
  ******************************************************************************/
-void pov_battery_level(POV_Display_TypeDef *display) {
-	display->top_string = "    Battery:    ";
+void pov_effect(void) {
+	if (!effect_mask_valid) {
+		TextCell_TypeDef top, bottom;
+
+		textcell_clear(&top);
+		textcell_clear(&bottom);
+		textcell_append_str(&top, "      HELLO     ", 0, TextCell_Left);
+		textcell_append_str(&bottom, "      WORLD     ", 0, TextCell_Left);
+		effects_text_mask(effect_mask, DISPLAY_NUM_PIXELS_WIDE, &top, &bottom);
+		effect_mask_valid = true;
+	}
 
-	char bottom[17];
-	uint32_t len = sprintf(bottom, "      %.2f", battery_get_percent());
-	for (uint32_t i = len; i < DISPLAY_NUM_CHARS; i++) {
-		bottom[i] = ' ';
+	POV_Frame_TypeDef *frame = pov_render_begin(false);
+	effect_phase++;
+	uint16_t hue = (uint16_t)(effect_phase * EFFECT_HUE_SPEED);
+
+	switch (displaymode) {
+	case EffectGradient:
+		effects_gradient(*frame, DISPLAY_NUM_PIXELS_WIDE, effect_mask, hue, EFFECT_HUE_PER_COLUMN, EFFECT_BRIGHTNESS);
+		break;
+	case EffectPlasma:
+		effects_plasma(*frame, DISPLAY_NUM_PIXELS_WIDE, effect_mask, effect_phase, EFFECT_BRIGHTNESS);
+		break;
+	case EffectFire:
+		effects_fire(*frame, DISPLAY_NUM_PIXELS_WIDE, effect_mask, EFFECT_BRIGHTNESS);
+		break;
+	case EffectColorCycle:
+		effects_color_cycle(*frame, DISPLAY_NUM_PIXELS_WIDE, effect_mask, hue, EFFECT_HUE_PER_ROW, EFFECT_BRIGHTNESS);
+		break;
+	default:
+		EFM_ASSERT(false);
+		break;
 	}
-	strcpy(display->bottom_string, bottom);
 
-	GRB_TypeDef color = { 0, 8, 0 };
+	pov_publish_frame(frame, 0);
+	marquee_active = false;
+	sprite_active = false;
+}
 
-	for (uint32_t i = 0; i < DISPLAY_NUM_CHARS; i++) {
-		display->top_colors[i] = color;
-		display->bottom_colors[i] = color;
+/***************************************************************************//**
+ * @brief
+ *		Scrolls the marquee message to the current time.
+ *
+ * @details
+ *		The marquee owns the latest render while it is active, and scrolls a
+ *		copy of it in the other display buffer. Any other mode that renders
+ *		into a display buffer clears marquee_active, so the full ring is
+ *		re-rendered when the marquee is shown again. The same applies to
+ *		sprite_active and the animation player.
+ *
+ ******************************************************************************/
+void pov_marquee(void) {
+	if (!marquee_active) {
+		GRB_TypeDef color = MARQUEE_COLOR;
+		marquee_init(&marquee, &font_large, marquee_text, color, MARQUEE_SPEED);
+		marquee_active = true;
+		sprite_active = false;
 	}
+
+	POV_Frame_TypeDef *frame = pov_render_begin(true);
+	pov_publish_frame(frame, marquee_update(&marquee, frame, pov_elapsed_ms()));
 }
 
 /***************************************************************************//**
  * @brief
- *		Begins the BMP280 read sequence.
+ *		Advances the animation to the current time.
+ *
+ * @details
+ *		A frame is only decoded when the animation moves on. Revolutions in
+ *		between publish the latest render again, in case a static frame
+ *		replaced it, without copying or decoding anything.
  *
  ******************************************************************************/
-void pov_bmp280_start(void) {
-	bmp280_read_temp();
+void pov_animation(void) {
+	if (!sprite_active) {
+		sprite_play(&sprite_player, &sprite_heart, pov_elapsed_ms());
+		sprite_active = true;
+		marquee_active = false;
+	}
+
+	if (!sprite_due(&sprite_player, pov_elapsed_ms())) {
+		pov_publish_frame(last_render, 0);
+		return;
+	}
+
+	POV_Frame_TypeDef *frame = pov_render_begin(true);
+	sprite_update(&sprite_player, frame, pov_elapsed_ms());
+	pov_publish_frame(frame, 0);
 }
 
 /***************************************************************************//**
  * @brief
- *		Opens POV and required peripherals.
+ *		Shows the streamed frame due now, waking the flash on entry.
  *
  * @details
- *		Opens TIMER0 for calibration measurements, and TIMER1 for display clocking.
+ *		Frames live in the stream's own ring, so the display buffers are
+ *		untouched.
+ *		If the flash holds no valid image, or the first frame has not arrived,
+ *		the filler frame is shown.
  *
  ******************************************************************************/
-void pov_filler(POV_Display_TypeDef *display) {
-	GRB_TypeDef top_color = { 6, 6, 6 };
-	GRB_TypeDef bottom_color = { 6, 6, 6 };
+void pov_stream(void) {
+	if (!flash_awake) {
+		mx25_open();
+		flash_awake = true;
+	}
+	if (!stream_active) {
+		stream_active = stream_open(POV_STREAM_ADDRESS, pov_elapsed_ms());
+	}
+
+	const POV_Frame_TypeDef *frame = stream_active ? stream_acquire(pov_elapsed_ms()) : NULL;
+	pov_show_static_frame(frame ? frame : &pov_frame_filler);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws the battery and pressure gauges.
+ *
+ * @details
+ *		Two dials share the same 120 degree sweep: the battery level fills the
+ *		inner LEDs, and a needle shows the pressure against a tick ring on the
+ *		outer LEDs. Redrawn whenever either reading changes.
+ *
+ ******************************************************************************/
+void pov_gauges(void) {
+	GRB_TypeDef track = { 1, 1, 1 };
+	GRB_TypeDef battery_color = { 8, 0, 0 };
+	GRB_TypeDef tick_color = { 2, 2, 4 };
+	GRB_TypeDef needle_color = { 3, 8, 0 };
+
+	POV_Frame_TypeDef *frame = pov_render_begin(false);
+	uint32_t start = cycles_now();
+	polar_clear(frame);
+
+	int32_t battery = readings[Sensor_Battery].values[0];
+	polar_arc(frame, GAUGE_START, (polar_angle_t)(GAUGE_START + GAUGE_SPAN), 1, track);
+	if (battery > 0) {
+		polar_sector(frame, GAUGE_START, (polar_angle_t)(GAUGE_START + GAUGE_SPAN * battery / 10000), 0, 2, battery_color);
+	}
+
+	int32_t pressure = readings[Sensor_BMP280].values[0] - GAUGE_PRESSURE_MIN_HPA;
+	if (pressure < 0) pressure = 0;
+	if (pressure > GAUGE_PRESSURE_RANGE_HPA) pressure = GAUGE_PRESSURE_RANGE_HPA;
+	polar_ticks(frame, GAUGE_START, (polar_angle_t)(GAUGE_START + GAUGE_SPAN),
+			GAUGE_SPAN * GAUGE_PRESSURE_TICK_HPA / GAUGE_PRESSURE_RANGE_HPA, 10, 11, tick_color);
+	polar_needle(frame, (polar_angle_t)(GAUGE_START + GAUGE_SPAN * pressure / GAUGE_PRESSURE_RANGE_HPA), 4, 11, needle_color);
+
+	uint32_t cost = cycles_now() - start;
+	if (cost > polar_max_cycles) {
+		polar_max_cycles = cost;
+	}
+
+	pov_publish_frame(frame, 0);
+	marquee_active = false;
+	sprite_active = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Draws an analog clock face.
+ *
+ * @details
+ *		The face is a circle placed off the axis of rotation, so it is drawn in
+ *		Cartesian form and every point is converted to a column and LED. Time
+ *		is counted from when the display started spinning.
+ *
+ ******************************************************************************/
+void pov_clock(void) {
+	GRB_TypeDef face_color = { 1, 2, 4 };
+	GRB_TypeDef mark_color = { 4, 4, 4 };
+	GRB_TypeDef hand_color = { 6, 6, 2 };
+	GRB_TypeDef second_color = { 0, 8, 0 };
+
+	uint32_t seconds = (pov_elapsed_ms() / 1000u) % CLOCK_SECONDS_PER_HALF_DAY;
+	POV_Frame_TypeDef *frame = pov_render_begin(false);
+	uint32_t start = cycles_now();
+	polar_clear(frame);
+
+	polar_circle(frame, 0, CLOCK_CENTER_Y, CLOCK_FACE_RADIUS, face_color);
+	for (uint32_t hour = 0; hour < 12; hour++) {
+		int32_t x, y;
+		polar_point((polar_angle_t)(hour * POLAR_FULL_TURN / 12), CLOCK_MARK_RADIUS, &x, &y);
+		polar_plot(frame, x, CLOCK_CENTER_Y + y, mark_color);
+	}
 
-	display->top_string = "     Filler     ";
-	display->bottom_string = "     Filler     ";
+	int32_t x, y;
+	polar_point((polar_angle_t)((uint64_t)seconds * POLAR_FULL_TURN / CLOCK_SECONDS_PER_HALF_DAY), CLOCK_HOUR_HAND, &x, &y);
+	polar_line(frame, 0, CLOCK_CENTER_Y, x, CLOCK_CENTER_Y + y, hand_color);
+	polar_point((polar_angle_t)((seconds % 3600u) * POLAR_FULL_TURN / 3600u), CLOCK_MINUTE_HAND, &x, &y);
+	polar_line(frame, 0, CLOCK_CENTER_Y, x, CLOCK_CENTER_Y + y, hand_color);
+	polar_point((polar_angle_t)((seconds % 60u) * POLAR_FULL_TURN / 60u), CLOCK_FACE_RADIUS, &x, &y);
+	polar_plot(frame, x, CLOCK_CENTER_Y + y, second_color);
+
+	uint32_t cost = cycles_now() - start;
+	if (cost > polar_max_cycles) {
+		polar_max_cycles = cost;
+	}
+
+	pov_publish_frame(frame, 0);
+	marquee_active = false;
+	sprite_active = false;
+}
 
-	for (uint32_t i = 0; i < DISPLAY_NUM_CHARS; i++) {
-		display->top_colors[i] = top_color;
-		display->bottom_colors[i] = bottom_color;
+/***************************************************************************//**
+ * @brief
+ *		Draws one line of a display in font_small, each character in its own
+ *		color.
+ *
+ * @param[in] y
+ * 		LED of the line's bottom row.
+ *
+ ******************************************************************************/
+static void pov_render_line(POV_Frame_TypeDef *frame, const TextCell_TypeDef *cell, const GRB_TypeDef *colors, uint32_t y) {
+	char line[TEXTCELL_CAPACITY + 1];
+	char glyph[2] = { 0 };
+	uint32_t first;
+	uint32_t x = fontengine_center_line(&font_small, cell->text, cell->length, DISPLAY_NUM_PIXELS_WIDE, line, &first);
+
+	for (uint32_t i = 0; line[i]; i++) {
+		glyph[0] = line[i];
+		x = fontengine_draw(frame, &font_small, glyph, x, y, colors[first + i]);
+		if (line[i + 1]) {
+			x += font_small.spacing + fontengine_kerning(&font_small, line[i], line[i + 1]);
+		}
 	}
 }
 
 /***************************************************************************//**
  * @brief
- *		Converts an HSV value to a GRB value.
+ *		Formats strings and color data to pixels data and writes to a frame.
  *
  * @details
- *		Implements formulas from https://www.rapidtables.com/convert/color/hsv-to-rgb.html
- *
- * @param[in] hue
- * 		The H value from 0 to 255.
- *
- * @param[in] saturation
- *		The S value from 0 to 255.
- *
- * @param[in] value
- * 		The V value from 0 to 255.
- *
- * @param[in] ret
- * 		The GRB_TypeDef variable to write the converted results to.
- ******************************************************************************/
-void hsv_to_grb(uint8_t hue, uint8_t saturation, uint8_t value, GRB_TypeDef *ret) {
-
-	// Convert hue to 360-degree scale and S/V to percent values
-	double H = ((double)hue) * 360 / 255;
-	double S = ((double)saturation) / 255;
-	double V = ((double)value) / 255;
-
-	// Formulas from rapidtables
-	double C, X, m, rp, gp, bp;
-	uint8_t g, r, b;
-
-	C = S * V;
-	X = C * (1 - fabs(fmod((H / 60), 2.0) - 1));
-	m = V - C;
-	if (0 <= H && H < 60) {
-		rp = C;
-		gp = X;
-		bp = 0;
-	} else if (60 <= H && H < 120) {
-		rp = X;
-		gp = C;
-		bp = 0;
-	} else if (120 <= H && H < 180) {
-		rp = 0;
-		gp = C;
-		bp = X;
-	} else if (180 <= H && H < 240) {
-		rp = 0;
-		gp = X;
-		bp = C;
-	} else if (240 <= H && H < 300) {
-		rp = X;
-		gp = 0;
-		bp = C;
-	} else if (300 <= H && H < 360) {
-		rp = C;
-		gp = 0;
-		bp = X;
-	}
-	g = (uint8_t)((gp + m) * 255);
-	r = (uint8_t)((rp + m) * 255);
-	b = (uint8_t)((bp + m) * 255);
-
-	// Update return variable
-	ret->g = g;
-	ret->r = r;
-	ret->b = b;
+ *		Draws each line in the proportional font_small, centered, with the
+ *		colors set in display struct. Positions past a string's length are
+ *		ignored. Every pixel of the frame is written.
+ *
+ * @param[out] frame
+ * 		The frame to render into: a display buffer or a page cache frame.
+ *
+ * @param[in] display
+ * 		A struct which contains a top string, bottom string, and colors for each
+ * 		character.
+ *
+ ******************************************************************************/
+void pov_render_display(POV_Frame_TypeDef *frame, const POV_Display_TypeDef *display) {
+	memset(frame, 0, sizeof(*frame));
+	pov_render_line(frame, &display->top_text, display->top_colors, DISPLAY_CHAR_PIXELS_HIGH);
+	pov_render_line(frame, &display->bottom_text, display->bottom_colors, 0);
 }
 
 //***********************************************************************************
 // Global functions
 //***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		TDD routine to validate that short strings render in full-width cells.
+ *
+ * @details
+ *		Renders a two-character top line over a cell whose unused positions
+ *		hold characters with no glyph, and an empty bottom line. Checks that
+ *		something is lit, and only within the two characters' width.
+ *
+ * @return
+ * 		True if the frame rendered as expected.
+ *
+ ******************************************************************************/
+bool pov_render_test(void) {
+	static POV_Frame_TypeDef frame;
+	POV_Display_TypeDef display;
+
+	memset(&display.top_text.text, 0x7F, sizeof(display.top_text.text));
+	memcpy(display.top_text.text, "Hi", 3);
+	display.top_text.length = 2;
+	textcell_clear(&display.bottom_text);
+	for (uint32_t i = 0; i < TEXTCELL_CAPACITY; i++) {
+		display.top_colors[i] = (GRB_TypeDef){ .g = 1, .r = 1, .b = 1 };
+		display.bottom_colors[i] = display.top_colors[i];
+	}
+
+	pov_render_display(&frame, &display);
+
+	uint32_t first = DISPLAY_NUM_PIXELS_WIDE;
+	uint32_t last = 0;
+	for (uint32_t column = 0; column < DISPLAY_NUM_PIXELS_WIDE; column++) {
+		for (uint32_t led = 0; led < WS2812B_NUM_LEDS; led++) {
+			if (frame[column][led].g | frame[column][led].r | frame[column][led].b) {
+				if (column < first) first = column;
+				last = column;
+			}
+		}
+	}
+
+	bool success = first <= last && last - first < fontengine_text_width(&font_small, "Hi");
+	EFM_ASSERT(success);
+	return success;
+}
 /***************************************************************************//**
  * @brief
  *		Opens POV and required peripherals.
@@ -306,10 +927,23 @@ void hsv_to_grb(uint8_t hue, uint8_t saturation, uint8_t value, GRB_TypeDef *ret
 void pov_open(void) {
 	// Reset all values
 	count_select = count_select_one;
-	count_one = 0;
-	count_two = 0;
-	humidity = 0;
-	temperature = 0;
+	rotation[0] = (POV_Rotation_TypeDef){ .half = measure };
+	rotation_seq = 0;
+	current_position = measure;
+	sweep_pulses = 0;
+	sweep_ticks_per_deg = 0;
+	active_frame = &display_buffers[0];
+	frame_offset = 0;
+	next_frame = NULL;
+	last_render = &display_buffers[0];
+	marquee_active = false;
+	sprite_active = false;
+	polar_max_cycles = 0;
+	column_max_latency = 0;
+	mode_stale = true;
+	elapsed_ms = 0;
+	elapsed_ticks = 0;
+	pagecache_init();
 
 	// Timer settings
 	TIMER_MEASURE_TypeDef timer_struct;
@@ -324,11 +958,12 @@ void pov_open(void) {
 	displaymode = TempHumidity;
 
 	// Open peripherals
+	cycles_open();
+	timer_struct.irq_priority = IRQ_PRIORITY_HALL;
 	timer_open(POV_MEASURE_TIMER, &timer_struct);
+	timer_struct.irq_priority = IRQ_PRIORITY_COLUMN;
 	timer_open(POV_TICK_TIMER, &timer_struct);
 	ws2812b_open();
-	si7021_i2c_open(ENVSENSE_I2C_PERIPHERAL, true);
-	bmp280_open(BMP280_TEMP_CB, BMP280_PRESSURE_CB);
 }
 
 /***************************************************************************//**
@@ -343,7 +978,8 @@ void pov_open(void) {
  *		CW of the bottom. This information is then used to find the ratio of the
  *		speed of the measurement timer to the speed of the display.
  *
- *		The timer also begins the tick timer depending on current position.
+ *		The new timing is published as one rotation state, and the column
+ *		interrupt is pended to start the tick timer from it.
  *
  * @param[in] count
  * 		The value to update the next counter with.
@@ -351,33 +987,50 @@ void pov_open(void) {
  ******************************************************************************/
 void pov_handle_measure(uint32_t count) {
 
+	// Keep real time while spinning; the measure timer restarts on every pulse
+	elapsed_ticks += count;
+	elapsed_ms += elapsed_ticks / POV_TICKS_PER_MS;
+	elapsed_ticks %= POV_TICKS_PER_MS;
+
+	POV_Rotation_TypeDef *next = pov_rotation_begin();
+	bool started = !next->spinning;
+
 	// Update the appropriate count value, switch to the other count value, and determine
-	// the current position of the display
+	// which half of the turn the display is in
 	if (count_select == count_select_one) {
-		count_one = count;
+		next->count_one = count;
 		count_select = count_select_two;
 
-		if (count_one > count_two) {
-			current_position = measure;
+		if (next->count_one > next->count_two) {
+			next->half = measure;
 		} else {
-			current_position = dead_one;
+			next->half = dead_one;
 		}
 	} else if (count_select == count_select_two) {
-		count_two = count;
+		next->count_two = count;
 		count_select = count_select_one;
 
-		if (count_two > count_one) {
-			current_position = measure;
+		if (next->count_two > next->count_one) {
+			next->half = measure;
 		} else {
-			current_position = dead_one;
+			next->half = dead_one;
 		}
 	} else EFM_ASSERT(false);
 
-	// Start display sequence, if necessary
-	if (current_position == dead_one) {
-		ticks_per_deg = (float)(count_one + count_two) / DEGREES_360;
-		timer_start(POV_TICK_TIMER, ticks_per_deg * DEAD_ZONE_WIDTH, UINT32_MAX);
+	if (next->half == dead_one) {
+		next->ticks_per_deg = (float)(next->count_one + next->count_two) / DEGREES_360;
+	}
+	next->pulses++;
+	next->spinning = true;
+	pov_rotation_publish();
+
+	// The column interrupt owns the tick timer; it picks up the new pulse and
+	// starts the dead zone timing if a sweep follows
+	NVIC_SetPendingIRQ(WTIMER1_IRQn);
 
+	// Render the first frame before the first sweep
+	if (started) {
+		add_scheduled_event(POV_RENDER_CB);
 	}
 }
 
@@ -386,14 +1039,20 @@ void pov_handle_measure(uint32_t count) {
  *		Begins the LED sequence.
  *
  * @details
- *		Resets display buffer, starts the tick timer, and sets current_position
- *		to display.
+ *		Ends any flash prefetch so the USART is free for LED data, swaps in a
+ *		frame published during the last sweep, resets the column index, starts
+ *		the tick timer, and sets current_position to display.
  *
  ******************************************************************************/
 void pov_start_display(void) {
-	pov_core();
+	stream_end_prefetch();
+	if (next_frame) {
+		active_frame = next_frame;
+		frame_offset = next_offset;
+		next_frame = NULL;
+	}
 	buffer_index = 0;
-	timer_start(POV_TICK_TIMER, ticks_per_deg * DISPLAY_ZONE_WIDTH, ticks_per_deg * DISPLAY_PIXEL_WIDTH);
+	timer_start(POV_TICK_TIMER, sweep_ticks_per_deg * DISPLAY_ZONE_WIDTH, sweep_ticks_per_deg * DISPLAY_PIXEL_WIDTH);
 	current_position = display;
 }
 
@@ -402,7 +1061,8 @@ void pov_start_display(void) {
  *		Ends the LED sequence.
  *
  * @details
- *		Turns off all LEDs and sets current_position to dead_two.
+ *		Turns off all LEDs, sets current_position to dead_two, and schedules
+ *		the next frame's render for the dark part of the turn.
  *
  ******************************************************************************/
 void pov_end_display(void) {
@@ -418,6 +1078,13 @@ void pov_end_display(void) {
 	// Write blanks to the LEDs
 	ws2812b_write(clear);
 	current_position = dead_two;
+	add_scheduled_event(POV_RENDER_CB);
+
+	// The LEDs are dark until the next display zone, so the shared USART is free
+	// to read ahead from the external flash
+	if (displaymode == Stream) {
+		stream_prefetch(pov_elapsed_ms());
+	}
 }
 
 /***************************************************************************//**
@@ -426,12 +1093,19 @@ void pov_end_display(void) {
  *
  * @details
  *		Writes from display buffer to LEDs, advances display buffer, and increases
- *		tick timer's compare value to next trigger point.
+ *		tick timer's compare value to next trigger point. The frame is read as a
+ *		ring starting at frame_offset, which lets the marquee scroll without
+ *		moving any pixels.
  *
  ******************************************************************************/
 void pov_tick(void) {
-	ws2812b_write(display_buffer[buffer_index]);
-	POV_TICK_TIMER->CC[0].CCV += (uint32_t)(ticks_per_deg * DISPLAY_PIXEL_WIDTH);
+	uint32_t column = buffer_index + frame_offset;
+	if (column >= DISPLAY_NUM_PIXELS_WIDE) {
+		column -= DISPLAY_NUM_PIXELS_WIDE;
+	}
+
+	ws2812b_write((*active_frame)[column]);
+	POV_TICK_TIMER->CC[0].CCV += (uint32_t)(sweep_ticks_per_deg * DISPLAY_PIXEL_WIDTH);
 	buffer_index++;
 }
 
@@ -440,12 +1114,12 @@ void pov_tick(void) {
  *		Formats strings and color data to pixels data and writes to display buffer.
  *
  * @details
- *		Converts strings to POV_CHAR arrays, then writes appropriate pixels with
- *		colors set in display struct.
+ *		Used by screens that change every revolution; screens rendered from
+ *		sensor readings go through the page cache instead.
  *
  * @note
- *		A low battery will always override the written value with "Low Battery
- *		/ Recharge Soon".
+ *		A low battery will always override the written value with the pre-rendered
+ *		"Low Battery / Recharge Soon" frame.
  *
  * @param[in] display
  * 		A struct which contains a top string, bottom string, and colors for each
@@ -457,139 +1131,127 @@ void pov_update_display(POV_Display_TypeDef display) {
 	// If the battery is low, display a low battery message regardless of what's
 	// been written to the display
 	if (battery_check_low()) {
-		display.top_string = "   Low Battery  ";
-		display.bottom_string = "  Recharge Soon ";
-
-		for (int i = 0; i < 16; i++) {
-			display.top_colors[i].g = 0;
-			display.top_colors[i].r = 63;
-			display.top_colors[i].b = 0;
-
-			display.bottom_colors[i].g = 31;
-			display.bottom_colors[i].r = 0;
-			display.bottom_colors[i].b = 31;
-		}
-	}
-
-
-	POV_CHAR top_chars[DISPLAY_NUM_CHARS];
-	POV_CHAR bottom_chars[DISPLAY_NUM_CHARS];
-
-	// Convert strings to arrays of POV_CHARs
-	for (uint32_t i = 0; i < DISPLAY_NUM_CHARS; i++) {
-		if (display.top_string[i] != '\0')
-			top_chars[i] = convert_to_pov_char(display.top_string[i]);
-		if (display.bottom_string[i] != '\0')
-			bottom_chars[i] = convert_to_pov_char(display.bottom_string[i]);
+		pov_show_static_frame(&pov_frame_low_battery);
+		return;
 	}
 
-	// Convert POV_CHARs into a series of twelve-wide WS2812B GRB values
-	for (uint32_t char_pos = 0; char_pos < DISPLAY_NUM_CHARS; char_pos++) {
-		for (uint32_t pixel_x = 0; pixel_x < DISPLAY_CHAR_PIXELS_WIDE; pixel_x++) {
-			for (uint32_t pixel_y = 0; pixel_y < DISPLAY_CHAR_PIXELS_HIGH; pixel_y++) {
+	POV_Frame_TypeDef *frame = pov_render_begin(false);
+	pov_render_display(frame, &display);
 
-				uint32_t disp_buf_pos = char_pos * (DISPLAY_CHAR_PIXELS_WIDE + 1) + pixel_x;
-				uint32_t char_shift = (pixel_x * (DISPLAY_CHAR_PIXELS_WIDE + 1) + pixel_y);
-
-				display_buffer[disp_buf_pos][pixel_y].g = ((bottom_chars[char_pos] >> char_shift) & 1u) * display.bottom_colors[char_pos].g;
-				display_buffer[disp_buf_pos][pixel_y].r = ((bottom_chars[char_pos] >> char_shift) & 1u) * display.bottom_colors[char_pos].r;
-				display_buffer[disp_buf_pos][pixel_y].b = ((bottom_chars[char_pos] >> char_shift) & 1u) * display.bottom_colors[char_pos].b;
-
-				display_buffer[disp_buf_pos][pixel_y + DISPLAY_CHAR_PIXELS_HIGH].g = ((top_chars[char_pos] >> char_shift) & 1u) * display.top_colors[char_pos].g;
-				display_buffer[disp_buf_pos][pixel_y + DISPLAY_CHAR_PIXELS_HIGH].r = ((top_chars[char_pos] >> char_shift) & 1u) * display.top_colors[char_pos].r;
-				display_buffer[disp_buf_pos][pixel_y + DISPLAY_CHAR_PIXELS_HIGH].b = ((top_chars[char_pos] >> char_shift) & 1u) * display.top_colors[char_pos].b;
-			}
-		}
-	}
+	pov_publish_frame(frame, 0);
+	marquee_active = false;
+	sprite_active = false;
 }
 
 /***************************************************************************//**
  * @brief
- *		Updates the humidity local static variable.
+ *		Shows a pre-rendered frame on the POV display.
+ *
+ * @details
+ *		Points the tick routine at a frame that is already in display format,
+ *		so no per-revolution rendering is required. Used for the constant
+ *		frames in pov_frames.c. During a sweep it is shown from the next one.
+ *
+ * @param[in] frame
+ * 		The frame to show, typically resident in flash.
+ *
  ******************************************************************************/
-void pov_update_humidity(void) {
-	humidity = si7021_calculate_humidity();
+void pov_show_static_frame(const POV_Frame_TypeDef *frame) {
+	pov_publish_frame(frame, 0);
 }
 
 /***************************************************************************//**
  * @brief
- *		Updates the humidity local static variable and updates display.
+ *		Returns the time the display has spent spinning, in milliseconds.
+ *
+ * @details
+ *		Accumulated from hall effect sensor pulse intervals, so it is accurate
+ *		to the measure timer and independent of the rotation rate. Does not
+ *		advance while the display is stopped.
  *
  ******************************************************************************/
-void pov_update_si7021_temp(void) {
-	/*
-	 * Create temperature  and humidity strings & pad leftover characters
-	 * with spaces
-	 */
-	POV_Display_TypeDef display;
-	char top[16];
-	float temp = si7021_calculate_temperature();
-	uint32_t len = sprintf(top, "Humidity: %.2f%%\n", humidity);
-
-	for (uint32_t i = len; i < DISPLAY_NUM_CHARS; i++) {
-		top[i] = ' ';
-	}
+uint32_t pov_elapsed_ms(void) {
+	return elapsed_ms;
+}
 
-	char bottom[16];
-	len = sprintf(bottom, "Temp: %.1fF", temp);
+/***************************************************************************//**
+ * @brief
+ *		Returns the longest gauge or clock render so far, in core clock
+ *		cycles, to check against the time the LEDs are dark.
+ *
+ ******************************************************************************/
+uint32_t pov_polar_max_cycles(void) {
+	return polar_max_cycles;
+}
 
-	for (uint32_t i = len; i < DISPLAY_NUM_CHARS; i++) {
-		bottom[i] = ' ';
+/***************************************************************************//**
+ * @brief
+ *		Returns true if background work may start now without running into
+ *		the next display sweep.
+ *
+ * @details
+ *		Uses a snapshot of the revolution timing predicted from the last two
+ *		hall pulses, taken without masking interrupts:
+ *		true if at least POV_BACKGROUND_QUIET_MS remain before the next sweep
+ *		starts. Always false during a sweep, and always true while the display
+ *		is stopped. Used as the scheduler's gate for background priorities;
+ *		the hall, display edge and stop interrupts all wake the main loop to
+ *		ask again.
+ *
+ ******************************************************************************/
+bool pov_background_ok(void) {
+	POV_Rotation_TypeDef rot;
+	pov_position position;
+	uint32_t now, seq;
+
+	do {
+		seq = pov_rotation_read(&rot);
+		position = (sweep_pulses == rot.pulses) ? current_position : rot.half;
+		now = POV_MEASURE_TIMER->CNT;
+	} while (seq != rotation_seq);
+
+	if (!rot.spinning) {
+		return true;
 	}
 
-
-	/* Write strings to display variable */
-	strcpy(display.top_string, top);
-	strcpy(display.bottom_string, bottom);
-
-
-	/* Write colors to display variable */
-	GRB_TypeDef top_text_color = { 2, 2, 4 };
-	GRB_TypeDef top_num_color = { 1, 1, 6};
-	GRB_TypeDef bottom_text_color = { 2, 4, 2 };
-	GRB_TypeDef bottom_num_color = { 1, 6, 1 };
-
-	for (uint32_t i = 0; i < 9; i++) {
-		display.top_colors[i] = top_text_color;
-	}
-	for (uint32_t i = 9; i < 16; i++) {
-		display.top_colors[i] = top_num_color;
-	}
-	for (uint32_t i = 0; i < 5; i++) {
-		display.bottom_colors[i] = bottom_text_color;
+	// Measure timer count, since the last pulse, at which the next sweep starts
+	uint32_t dead_zone = rot.ticks_per_deg * DEAD_ZONE_WIDTH;
+	uint32_t due;
+	if (position == display) {
+		return false;
+	} else if (position == dead_one) {
+		due = dead_zone;
+	} else if (position == dead_two) {
+		due = rot.count_one + rot.count_two + dead_zone;
+	} else {
+		// The next pulse starts the displayed half, after the shorter interval
+		due = (rot.count_one < rot.count_two ? rot.count_one : rot.count_two) + dead_zone;
 	}
-	for (uint32_t i = 5; i < 16; i++) {
-		display.bottom_colors[i] = bottom_num_color;
-	}
-
-	pov_update_display(display);
+	return (int32_t)(due - now) >= (int32_t)(POV_BACKGROUND_QUIET_MS * POV_TICKS_PER_MS);
 }
 
 /***************************************************************************//**
  * @brief
- *		Shows the current pressure and altitude estimate on the display.
+ *		Returns the longest delay so far from a column's compare match to its
+ *		interrupt running, in POV_TICK_TIMER ticks. At prescale 1 these are
+ *		HFPERCLK cycles.
+ *
+ * @details
+ *		This is how the before and after figures for the column path are taken:
+ *		spin the wheel with the display and sensors running, call this with
+ *		reset true, let it run for a minute and read it again. No figures have
+ *		been recorded yet; they need the hardware.
+ *
+ * @param[in] reset
+ * 		If true, the worst case is cleared after it is read.
  *
  ******************************************************************************/
-void pov_update_bmp280(void) {
-	POV_Display_TypeDef display;
-
-	char top[17];
-	float pressure = bmp280_get_last_pressure_read() / 100;
-	uint32_t len = sprintf(top, "Pressure: %.0fhPa", pressure);
-
-	for (uint32_t i = len; i < DISPLAY_NUM_CHARS; i++) {
-		top[i] = ' ';
-	}
-
-	char bottom[17];
-	float altitude = bmp280_get_altitude();
-	len = sprintf(bottom, "Altitude: %.1fm", altitude);
-
-	for (uint32_t i = len; i < DISPLAY_NUM_CHARS; i++) {
-		bottom[i] = ' ';
+uint32_t pov_column_max_latency(bool reset) {
+	uint32_t latency = column_max_latency;
+	if (reset) {
+		column_max_latency = 0;
 	}
-
-	pov_update_display(display);
+	return latency;
 }
 
 /***************************************************************************//**
@@ -597,14 +1259,17 @@ void pov_update_bmp280(void) {
  *		Shows the "menu" to select the current display option.
  *
  * @details
- *		True = Display is spinning, displaying current data.
- *		False = display is stopped, "menu" mode.
- *
- * @param[in] new_state
- * 		The state to set the display to.
+ *		Lights one LED in the selected mode's color while the display is
+ *		stopped. Runs from the main loop; while the display spins, the column
+ *		interrupt owns the LEDs and the mode shows on the next sweep instead.
  *
  ******************************************************************************/
 void pov_show_menu(void) {
+	POV_Rotation_TypeDef rot;
+	pov_rotation_read(&rot);
+	if (rot.spinning) {
+		return;
+	}
 
 	// Create an empty array of GRB values
 	GRB_TypeDef display[WS2812B_NUM_LEDS];
@@ -615,44 +1280,7 @@ void pov_show_menu(void) {
 	}
 
 	// Turn one LED on depending on the mode selected
-	switch(displaymode) {
-	case HelloWorld:
-		display[0].g = 8;
-		break;
-	case TempHumidity:
-		display[1].g = 8;
-		break;
-	case Credits:
-		display[2].g = 8;
-		break;
-	case BatteryLevel:
-		display[3].g = 8;
-		break;
-	case PressureAltitude:
-		display[4].g = 8;
-		break;
-	case Filler6:
-		display[5].g = 8;
-		break;
-	case Filler7:
-		display[6].g = 8;
-		break;
-	case Filler8:
-		display[7].g = 8;
-		break;
-	case Filler9:
-		display[8].g = 8;
-		break;
-	case Filler10:
-		display[9].g = 8;
-		break;
-	case Filler11:
-		display[10].g = 8;
-		break;
-	case Filler12:
-		display[11].g = 8;
-		break;
-	}
+	display[modes[displaymode].menu_led] = modes[displaymode].menu_color;
 
 	ws2812b_write(display);
 }
@@ -661,51 +1289,22 @@ void pov_show_menu(void) {
  * @brief
  *		Scrolls through operation modes.
  *
+ * @details
+ *		Runs from the main loop, scheduled by the button interrupts.
+ *
  * @param[in] right
  * 		Determines the direction to scroll through the modes.
  *
  ******************************************************************************/
 void pov_change_mode(bool direction) {
 
-	// Scroll to the next mode depending on the previous.
-	switch(displaymode) {
-	case HelloWorld:
-		displaymode = direction ? Filler12 : TempHumidity;
-		break;
-	case TempHumidity:
-		displaymode = direction ? HelloWorld : Credits;
-		break;
-	case Credits:
-		displaymode = direction ? TempHumidity : BatteryLevel;
-		break;
-	case BatteryLevel:
-		displaymode = direction ? Credits : PressureAltitude;
-		break;
-	case PressureAltitude:
-		displaymode = direction ? BatteryLevel : Filler6;
-		break;
-	case Filler6:
-		displaymode = direction ? PressureAltitude : Filler7;
-		break;
-	case Filler7:
-		displaymode = direction ? Filler6 : Filler8;
-		break;
-	case Filler8:
-		displaymode = direction ? Filler7 : Filler9;
-		break;
-	case Filler9:
-		displaymode = direction ? Filler8 : Filler10;
-		break;
-	case Filler10:
-		displaymode = direction ? Filler9 : Filler11;
-		break;
-	case Filler11:
-		displaymode = direction ? Filler10 : Filler12;
-		break;
-	case Filler12:
-		displaymode = direction ? Filler11 : HelloWorld;
-		break;
+	// Scroll to the next mode, wrapping around the registry
+	if (direction) {
+		displaymode = (displaymode == 0) ? POV_NUM_MODES - 1 : displaymode - 1;
+	} else {
+		displaymode = (displaymode + 1) % POV_NUM_MODES;
 	}
+	mode_stale = true;
 
 	pov_show_menu();
 }
@@ -715,15 +1314,25 @@ void pov_change_mode(bool direction) {
  *		Interrupt handler for TIMER1.
  *
  * @details
- *		If the timer has reached the end of a one-shot, will start or stop the
- *		display cycle as appropriate. If the timer has reached the compare value,
- *		the display will be advanced.
+ *		Also pended by the hall interrupt after each pulse. If the timer has
+ *		reached the end of a one-shot, will start or stop the display cycle as
+ *		appropriate. If the timer has reached the compare value, the display
+ *		will be advanced.
  *
  ******************************************************************************/
 void WTIMER1_IRQHandler(void) {
+	uint32_t entry = WTIMER1->CNT;
 	uint32_t int_flag = WTIMER1->IF & WTIMER1->IEN;
 	WTIMER1->IFC = int_flag;
 
+	// A new hall pulse restarts the turn; flags from the old timing are stale
+	POV_Rotation_TypeDef rot;
+	pov_rotation_read(&rot);
+	if (rot.pulses != sweep_pulses) {
+		pov_follow_pulse(&rot);
+		return;
+	}
+
 	// Interrupts from overflow
 	if (int_flag & TIMER_IF_OF) {
 		if (current_position == dead_one) {
@@ -736,6 +1345,10 @@ void WTIMER1_IRQHandler(void) {
 
 	// Interrupts from CC0
 	if (int_flag & TIMER_IF_CC0) {
+		uint32_t latency = entry - WTIMER1->CC[0].CCV;
+		if (latency > column_max_latency) {
+			column_max_latency = latency;
+		}
 		pov_tick();
 	}
 }
@@ -746,7 +1359,7 @@ void WTIMER1_IRQHandler(void) {
  *
  * @details
  *		If TIMER0 (the timer used for calibration) overflows, it is assumed that
- *		the display has stopped spinning, and the "menu" mode is activated.
+ *		the display has stopped spinning, and the "menu" is scheduled.
  *
  ******************************************************************************/
 void WTIMER0_IRQHandler(void) {
@@ -754,7 +1367,9 @@ void WTIMER0_IRQHandler(void) {
 	WTIMER0->IFC = int_flag;
 
 	if (int_flag & TIMER_IF_OF) {
-		pov_show_menu();
+		pov_rotation_begin()->spinning = false;
+		pov_rotation_publish();
+		add_scheduled_event(POV_MENU_CB);
 		timer_measure_restart(POV_MEASURE_TIMER);
 	}
 }
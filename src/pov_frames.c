@@ -0,0 +1,168 @@
+/**
+ * @file pov_frames.c
+ * @brief Pre-rendered, flash-resident frames for the constant display modes.
+ *
+ * @note Generated by tools/framegen.py from small.txt. Do not edit.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "pov_frames.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define CREDITS_TOP_COLOR          { 6, 6, 6 }
+#define CREDITS_BOTTOM_COLOR       { 10, 8, 0 }
+#define FILLER_TOP_COLOR           { 6, 6, 6 }
+#define FILLER_BOTTOM_COLOR        { 6, 6, 6 }
+#define LOW_BATTERY_TOP_COLOR      { 0, 63, 0 }
+#define LOW_BATTERY_BOTTOM_COLOR   { 31, 0, 31 }
+
+//***********************************************************************************
+// Global variables
+//***********************************************************************************
+
+// "Keith Graham" / "Peter Magro"
+const POV_Frame_TypeDef pov_frame_credits = {
+	[20] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[21] = { [9] = CREDITS_TOP_COLOR },
+	[22] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[23] = { [2] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[24] = { [2] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[25] = { [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR },
+	[26] = { [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[27] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[28] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[29] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[30] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR },
+	[31] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[32] = { [3] = CREDITS_BOTTOM_COLOR },
+	[33] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[34] = { [0] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[35] = { [6] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[36] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR },
+	[37] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[38] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[39] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[40] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR },
+	[41] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR },
+	[42] = { [2] = CREDITS_BOTTOM_COLOR },
+	[43] = { [3] = CREDITS_BOTTOM_COLOR },
+	[44] = { [3] = CREDITS_BOTTOM_COLOR },
+	[45] = { [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[46] = { [6] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[47] = { [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[48] = { [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[49] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[50] = { [4] = CREDITS_BOTTOM_COLOR },
+	[51] = { [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[52] = { [4] = CREDITS_BOTTOM_COLOR, [8] = CREDITS_TOP_COLOR },
+	[53] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [5] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[54] = { [9] = CREDITS_TOP_COLOR },
+	[55] = { [1] = CREDITS_BOTTOM_COLOR },
+	[56] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [7] = CREDITS_TOP_COLOR },
+	[57] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[58] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[59] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[60] = { [3] = CREDITS_BOTTOM_COLOR },
+	[61] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR, [11] = CREDITS_TOP_COLOR },
+	[62] = { [0] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[63] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [4] = CREDITS_BOTTOM_COLOR, [9] = CREDITS_TOP_COLOR },
+	[64] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR },
+	[65] = { [0] = CREDITS_BOTTOM_COLOR, [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR },
+	[66] = { [2] = CREDITS_BOTTOM_COLOR, [7] = CREDITS_TOP_COLOR },
+	[67] = { [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[68] = { [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[69] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[70] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR },
+	[71] = { [0] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR, [10] = CREDITS_TOP_COLOR },
+	[72] = { [0] = CREDITS_BOTTOM_COLOR, [3] = CREDITS_BOTTOM_COLOR, [10] = CREDITS_TOP_COLOR },
+	[73] = { [1] = CREDITS_BOTTOM_COLOR, [2] = CREDITS_BOTTOM_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+	[74] = { [11] = CREDITS_TOP_COLOR },
+	[75] = { [6] = CREDITS_TOP_COLOR, [7] = CREDITS_TOP_COLOR, [8] = CREDITS_TOP_COLOR, [9] = CREDITS_TOP_COLOR },
+};
+
+// "Filler" / "Filler"
+const POV_Frame_TypeDef pov_frame_filler = {
+	[37] = { [0] = FILLER_BOTTOM_COLOR, [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [5] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR, [11] = FILLER_TOP_COLOR },
+	[38] = { [3] = FILLER_BOTTOM_COLOR, [5] = FILLER_BOTTOM_COLOR, [9] = FILLER_TOP_COLOR, [11] = FILLER_TOP_COLOR },
+	[39] = { [3] = FILLER_BOTTOM_COLOR, [5] = FILLER_BOTTOM_COLOR, [9] = FILLER_TOP_COLOR, [11] = FILLER_TOP_COLOR },
+	[40] = { [5] = FILLER_BOTTOM_COLOR, [11] = FILLER_TOP_COLOR },
+	[42] = { [0] = FILLER_BOTTOM_COLOR, [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR },
+	[44] = { [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [5] = FILLER_BOTTOM_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR, [11] = FILLER_TOP_COLOR },
+	[45] = { [0] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR },
+	[47] = { [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [5] = FILLER_BOTTOM_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR, [11] = FILLER_TOP_COLOR },
+	[48] = { [0] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR },
+	[50] = { [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR },
+	[51] = { [0] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR },
+	[52] = { [0] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [4] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [10] = FILLER_TOP_COLOR },
+	[53] = { [0] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR },
+	[55] = { [0] = FILLER_BOTTOM_COLOR, [1] = FILLER_BOTTOM_COLOR, [2] = FILLER_BOTTOM_COLOR, [3] = FILLER_BOTTOM_COLOR, [6] = FILLER_TOP_COLOR, [7] = FILLER_TOP_COLOR, [8] = FILLER_TOP_COLOR, [9] = FILLER_TOP_COLOR },
+	[56] = { [2] = FILLER_BOTTOM_COLOR, [8] = FILLER_TOP_COLOR },
+	[57] = { [3] = FILLER_BOTTOM_COLOR, [9] = FILLER_TOP_COLOR },
+	[58] = { [3] = FILLER_BOTTOM_COLOR, [9] = FILLER_TOP_COLOR },
+};
+
+// "Low Battery" / "Recharge Soon"
+const POV_Frame_TypeDef pov_frame_low_battery = {
+	[16] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR },
+	[17] = { [2] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR },
+	[18] = { [2] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR },
+	[19] = { [2] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR },
+	[20] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR },
+	[22] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[23] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR },
+	[24] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR },
+	[25] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR },
+	[27] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[28] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[29] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[30] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[32] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[33] = { [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR },
+	[34] = { [3] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[35] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR },
+	[36] = { [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[37] = { [1] = LOW_BATTERY_BOTTOM_COLOR },
+	[38] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR },
+	[39] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR },
+	[40] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR },
+	[41] = { [6] = LOW_BATTERY_TOP_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[42] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[43] = { [2] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[44] = { [3] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[45] = { [3] = LOW_BATTERY_BOTTOM_COLOR },
+	[46] = { [7] = LOW_BATTERY_TOP_COLOR },
+	[47] = { [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[48] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[49] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[50] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR },
+	[51] = { [9] = LOW_BATTERY_TOP_COLOR },
+	[52] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[53] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[54] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR },
+	[55] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[56] = { [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR, [11] = LOW_BATTERY_TOP_COLOR },
+	[57] = { [6] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[59] = { [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[60] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [4] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[61] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[62] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[63] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [5] = LOW_BATTERY_BOTTOM_COLOR },
+	[64] = { [6] = LOW_BATTERY_TOP_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[65] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[66] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[67] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [9] = LOW_BATTERY_TOP_COLOR },
+	[68] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR },
+	[69] = { [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[70] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[71] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [6] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR },
+	[72] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR, [7] = LOW_BATTERY_TOP_COLOR, [8] = LOW_BATTERY_TOP_COLOR, [9] = LOW_BATTERY_TOP_COLOR, [10] = LOW_BATTERY_TOP_COLOR },
+	[73] = { [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR },
+	[75] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR, [3] = LOW_BATTERY_BOTTOM_COLOR },
+	[76] = { [3] = LOW_BATTERY_BOTTOM_COLOR },
+	[77] = { [3] = LOW_BATTERY_BOTTOM_COLOR },
+	[78] = { [0] = LOW_BATTERY_BOTTOM_COLOR, [1] = LOW_BATTERY_BOTTOM_COLOR, [2] = LOW_BATTERY_BOTTOM_COLOR },
+};
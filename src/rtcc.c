@@ -0,0 +1,162 @@
+/**
+ * @file rtcc.c
+ * @author Peter Magro
+ * @date August 19th, 2021
+ * @brief Free-running RTCC time base with a one-shot compare.
+ *
+ * @note The counter runs from the LFXO on the LFE clock tree and keeps counting
+ * 			in EM2. Compare channel 0 wakes the software timer wheel at its next
+ * 			expiry; the counter itself is never reloaded.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "rtcc.h"
+
+//** Silicon Lab include files
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_assert.h"
+
+//** User/developer include files
+#include "scheduler.h"
+#include "irq.h"
+#include "sleep_routines.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define RTCC_WAKE_CHANNEL		0
+
+//***********************************************************************************
+// Private variables
+//***********************************************************************************
+static uint32_t scheduled_cb;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Starts the RTCC counter with the compare stopped.
+ *
+ * @details
+ *		The LFE clock tree must already be routed to the LFXO by cmu_open().
+ *		The counter is never stopped, so rtcc_now() is valid from here on.
+ *
+ ******************************************************************************/
+void rtcc_open(void) {
+	RTCC_Init_TypeDef init = RTCC_INIT_DEFAULT;
+	RTCC_CCChConf_TypeDef compare = RTCC_CH_INIT_COMPARE_DEFAULT;
+
+	CMU_ClockEnable(cmuClock_RTCC, true);
+
+	init.enable = false;
+	init.debugRun = false;
+	init.presc = rtccCntPresc_32;			// 32768 Hz / 32 = RTCC_HZ
+	init.prescMode = rtccCntTickPresc;
+	RTCC_Init(&init);
+
+	RTCC_ChannelInit(RTCC_WAKE_CHANNEL, &compare);
+	RTCC_IntDisable(RTCC_IEN_CC0);
+	RTCC_IntClear(RTCC_IF_CC0);
+	NVIC_SetPriority(RTCC_IRQn, IRQ_PRIORITY_BACKGROUND);
+	NVIC_EnableIRQ(RTCC_IRQn);
+
+	RTCC_Enable(true);
+	sleep_block_mode(RTCC_EM);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Schedules an event at a counter value.
+ *
+ * @details
+ *		Replaces any compare already set. A tick less than RTCC_MIN_LEAD
+ *		ticks away, or already past, is moved to RTCC_MIN_LEAD ticks from
+ *		now so that the match cannot be missed.
+ *
+ * @param[in] tick
+ * 		The counter value at which to schedule the event.
+ *
+ * @param[in] cb
+ * 		The event to schedule, once.
+ *
+ ******************************************************************************/
+void rtcc_compare_start(uint32_t tick, uint32_t cb) {
+	IRQ_DECLARE_STATE;
+	IRQ_ENTER_BACKGROUND();
+
+	uint32_t now = RTCC_CounterGet();
+	if ((int32_t)(tick - now) < (int32_t)RTCC_MIN_LEAD) {
+		tick = now + RTCC_MIN_LEAD;
+	}
+
+	scheduled_cb = cb;
+	RTCC_ChannelCCVSet(RTCC_WAKE_CHANNEL, tick);
+	RTCC_IntClear(RTCC_IF_CC0);
+	RTCC_IntEnable(RTCC_IEN_CC0);
+
+	IRQ_EXIT_BACKGROUND();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Cancels the compare. An event already scheduled is not removed.
+ *
+ ******************************************************************************/
+void rtcc_compare_stop(void) {
+	IRQ_DECLARE_STATE;
+	IRQ_ENTER_BACKGROUND();
+	RTCC_IntDisable(RTCC_IEN_CC0);
+	RTCC_IntClear(RTCC_IF_CC0);
+	IRQ_EXIT_BACKGROUND();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the counter, in ticks of 1 / RTCC_HZ seconds.
+ *
+ ******************************************************************************/
+uint32_t rtcc_now(void) {
+	return RTCC_CounterGet();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the time since rtcc_open() in milliseconds.
+ *
+ * @note
+ *		The 32-bit counter wraps after about 48 days, at which point the
+ *		result jumps back to 0.
+ *
+ ******************************************************************************/
+uint32_t rtcc_now_ms(void) {
+	return (uint32_t)(((uint64_t)RTCC_CounterGet() * 1000u) / RTCC_HZ);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		RTCC interrupt handler.
+ *
+ * @details
+ *		The compare is one-shot: it is disabled on a match and its event is
+ *		scheduled.
+ *
+ ******************************************************************************/
+void RTCC_IRQHandler(void) {
+	uint32_t int_flag = RTCC_IntGetEnabled();
+	RTCC_IntClear(int_flag);
+
+	if (int_flag & RTCC_IF_CC0) {
+		RTCC_IntDisable(RTCC_IEN_CC0);
+		add_scheduled_event(scheduled_cb);
+	}
+}
@@ -3,6 +3,19 @@
  * @author Peter Magro
  * @date June 21st, 2021
  * @brief Contains all scheduler functions.
+ *
+ * @note Events are still identified by single-bit ids, so drivers keep
+ * 			passing them around as uint32_t callbacks. Each event is registered
+ * 			with a handler and a priority. Posted events wait in a bounded FIFO
+ * 			for their priority, and scheduler_dispatch() runs the oldest event
+ * 			of the highest non-empty priority, found with one CLZ.
+ *
+ * @note Interrupts never touch the priority queues. An event posted from an
+ * 			interrupt goes into a lock-free ring for that interrupt's NVIC
+ * 			priority, and the main loop moves it into its queue before
+ * 			dispatching. Handlers at one NVIC priority cannot preempt each
+ * 			other, so each ring has a single producer, and no post or dispatch
+ * 			masks interrupts.
  */
 
 /*
@@ -10,60 +23,243 @@
  */
 #include "scheduler.h"
 
-#include "em_core.h"
+#include "em_assert.h"
+#include "em_device.h"
+
+#include "irq.h"
+#include "spsc.h"
 
 /*
  * defines
  */
-#define CLEAR_EVENTS		0x00
+#define CLEAR_EVENTS			0x00
+#define SCHEDULER_INDEX(event)	(31u - __builtin_clz(event))
+#define SCHEDULER_NUM_RINGS		(1u << __NVIC_PRIO_BITS)	// One per NVIC priority
 
 
 /*
  * private variables
  */
-static unsigned int event_scheduled;
+static struct {
+	Scheduler_Handler_TypeDef handler;
+	uint8_t priority;
+	bool coalesce;						// A post while already queued updates the payload only
+	uint8_t queued;						// Instances waiting in the queue
+	uint32_t payload;					// Latest payload of a coalescing event
+	Scheduler_Stats_TypeDef stats;
+} events[SCHEDULER_NUM_EVENTS];
+
+static struct {
+	uint8_t event[SCHEDULER_QUEUE_DEPTH];	// Index into events[]
+	uint32_t payload[SCHEDULER_QUEUE_DEPTH];
+	uint8_t head;
+	uint8_t count;
+} queues[SCHEDULER_NUM_PRIORITIES];
+
+static uint32_t ready;					// Bit n set while queues[n] is not empty
+static uint32_t event_scheduled;		// Ids of the events with an instance queued
+
+static uint32_t gated;					// Bit n set if priority n waits for gate_open()
+static Scheduler_Gate_TypeDef gate_open;
+
+// Events posted from interrupts, waiting to be queued by the main loop
+static Spsc_Ring_TypeDef rings[SCHEDULER_NUM_RINGS];
+
+/*
+ * private functions
+ */
+
+/***************************************************************************//**
+ * @brief
+ *		Queues an event behind others of the same priority.
+ *
+ * @details
+ *		If that queue is full the event is dropped and counted; a coalescing
+ *		event that is already queued is counted as coalesced instead. Main
+ *		loop only.
+ *
+ ******************************************************************************/
+static void scheduler_enqueue(uint32_t i, uint32_t payload) {
+	events[i].stats.posted++;
+
+	if (!events[i].handler) {
+		events[i].stats.unhandled++;
+	} else if (events[i].coalesce && events[i].queued) {
+		events[i].payload = payload;
+		events[i].stats.coalesced++;
+	} else if (queues[events[i].priority].count == SCHEDULER_QUEUE_DEPTH) {
+		events[i].stats.dropped++;
+	} else {
+		uint32_t priority = events[i].priority;
+		uint32_t slot = (queues[priority].head + queues[priority].count) % SCHEDULER_QUEUE_DEPTH;
+
+		queues[priority].event[slot] = i;
+		queues[priority].payload[slot] = payload;
+		queues[priority].count++;
+		events[i].queued++;
+		events[i].payload = payload;
+		ready |= 1u << priority;
+		event_scheduled |= 1u << i;
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the ready mask less any priorities held by the gate.
+ *
+ * @details
+ *		The gate is only asked when a gated priority has work waiting.
+ *
+ ******************************************************************************/
+static uint32_t scheduler_runnable_mask(void) {
+	if ((ready & gated) && !gate_open()) {
+		return ready & ~gated;
+	}
+	return ready;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Moves every event posted from an interrupt into its queue.
+ *
+ * @details
+ *		Main loop only. Rings are emptied from the highest NVIC priority down.
+ *
+ ******************************************************************************/
+static void scheduler_drain(void) {
+	uint32_t event, payload;
+
+	for (uint32_t r = 0; r < SCHEDULER_NUM_RINGS; r++) {
+		while (spsc_pop(&rings[r], &event, &payload)) {
+			scheduler_enqueue(SCHEDULER_INDEX(event), payload);
+		}
+	}
+}
+
+/*
+ * global functions
+ */
 
 /***************************************************************************//**
  * @brief
  *		Prepares the scheduler to be used.
  *
  * @details
- *		Opens the scheduler functionality by resetting the static/private variable event_scheduled to 0.
+ *		Empties every queue and clears all registrations and counters.
  *
  * @note
  *		This function is atomic.
  *
  ******************************************************************************/
 void scheduler_open(void) {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+	IRQ_DECLARE_STATE;
+	IRQ_ENTER_BACKGROUND();
 
+	for (uint32_t i = 0; i < SCHEDULER_NUM_EVENTS; i++) {
+		events[i] = (typeof(events[i])){ 0 };
+	}
+	for (uint32_t i = 0; i < SCHEDULER_NUM_PRIORITIES; i++) {
+		queues[i].head = 0;
+		queues[i].count = 0;
+	}
+	for (uint32_t i = 0; i < SCHEDULER_NUM_RINGS; i++) {
+		spsc_init(&rings[i]);
+	}
+	ready = CLEAR_EVENTS;
 	event_scheduled = CLEAR_EVENTS;
+	gated = 0;
+	gate_open = NULL;
+
+	IRQ_EXIT_BACKGROUND();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Registers the handler for an event.
+ *
+ * @details
+ *		Main loop only. Events posted before their handler is registered are
+ *		counted as unhandled and discarded.
+ *
+ * @param[in] event
+ * 		The event id, a single bit.
+ *
+ * @param[in] priority
+ * 		0 to SCHEDULER_NUM_PRIORITIES - 1; higher priorities are dispatched
+ * 		first.
+ *
+ * @param[in] coalesce
+ * 		If true, posting the event while an instance is already queued only
+ * 		replaces its payload, as the old bitmask scheduler did. If false,
+ * 		every post is queued separately.
+ *
+ * @param[in] handler
+ * 		Called from scheduler_dispatch() with the event's payload.
+ *
+ ******************************************************************************/
+void scheduler_register(uint32_t event, uint32_t priority, bool coalesce, Scheduler_Handler_TypeDef handler) {
+	EFM_ASSERT(event != 0 && (event & (event - 1)) == 0);
+	EFM_ASSERT(priority < SCHEDULER_NUM_PRIORITIES);
+	EFM_ASSERT(handler);
 
-	CORE_EXIT_CRITICAL();
+	uint32_t i = SCHEDULER_INDEX(event);
+	EFM_ASSERT(events[i].queued == 0);
+	events[i].handler = handler;
+	events[i].priority = priority;
+	events[i].coalesce = coalesce;
 }
 
 /***************************************************************************//**
  * @brief
- *		Adds a new event to the scheduler.
+ *		Adds a new event to the scheduler with no payload.
  *
  * @details
- *		ORs a new event, the input argument, with the existing state of the static variable event_scheduled.
+ *		An event of 0 is ignored, for drivers whose callback is optional.
  *
  * @note
- *		This function is atomic.
+ *		Never masks interrupts; may be called from interrupts.
  *
  * @param[in] event
  * 		The event to add to the scheduler.
  *
  ******************************************************************************/
 void add_scheduled_event(uint32_t event) {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+	add_scheduled_event_data(event, 0);
+}
 
-	event_scheduled |= event;
+/***************************************************************************//**
+ * @brief
+ *		Adds a new event to the scheduler with a payload word.
+ *
+ * @details
+ *		From the main loop the event is queued at once. From an interrupt it is
+ *		pushed onto the ring for the interrupt's NVIC priority and queued
+ *		before the next dispatch; if that ring is full it is dropped and
+ *		counted in the totals.
+ *
+ * @note
+ *		Never masks interrupts; may be called from interrupts.
+ *
+ * @param[in] event
+ * 		The event to add to the scheduler, a single bit.
+ *
+ * @param[in] payload
+ * 		Passed to the event's handler.
+ *
+ ******************************************************************************/
+void add_scheduled_event_data(uint32_t event, uint32_t payload) {
+	if (event == 0) {
+		return;
+	}
+	EFM_ASSERT((event & (event - 1)) == 0);
+
+	uint32_t exception = __get_IPSR();
 
-	CORE_EXIT_CRITICAL();
+	if (exception == 0) {
+		scheduler_enqueue(SCHEDULER_INDEX(event), payload);
+	} else {
+		spsc_push(&rings[NVIC_GetPriority((IRQn_Type)((int32_t)exception - 16))], event, payload);
+	}
 }
 
 /***************************************************************************//**
@@ -71,30 +267,176 @@ void add_scheduled_event(uint32_t event) {
  *		Removes an event from the scheduler.
  *
  * @details
- *		Inverts then ANDs an event, the input argument, with the existing state of the static variable event_scheduled
+ *		Every queued instance of each event in the input argument is
+ *		removed, including any posted from an interrupt and not yet queued,
+ *		and the queues are compacted so that the slots are free again.
  *
  * @note
- *		This function is atomic.
+ *		Main loop only.
  *
  * @param[in] event
- * 		The event to remove from the scheduler.
+ * 		The event to remove from the scheduler; may have several bits set.
  *
  ******************************************************************************/
 void remove_scheduled_event(uint32_t event) {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
+	scheduler_drain();
 
-	event_scheduled &= ~event;
+	uint32_t queued = event & event_scheduled;
+
+	for (uint32_t p = 0; p < SCHEDULER_NUM_PRIORITIES && queued; p++) {
+		uint32_t kept = 0;
+
+		for (uint32_t n = 0; n < queues[p].count; n++) {
+			uint32_t from = (queues[p].head + n) % SCHEDULER_QUEUE_DEPTH;
+			uint32_t to = (queues[p].head + kept) % SCHEDULER_QUEUE_DEPTH;
+			uint32_t i = queues[p].event[from];
 
-	CORE_EXIT_CRITICAL();
+			if (queued & (1u << i)) {
+				events[i].queued--;
+			} else {
+				queues[p].event[to] = i;
+				queues[p].payload[to] = queues[p].payload[from];
+				kept++;
+			}
+		}
+		queues[p].count = kept;
+		if (kept == 0) {
+			ready &= ~(1u << p);
+		}
+	}
+	event_scheduled &= ~event;
 }
 
-// Returns the current state of the static variable event_scheduled
 /***************************************************************************//**
  * @brief
- *		Returns the event_scheduled variable.
+ *		Returns the ids of all events waiting to be dispatched, ORed together.
+ *
+ * @details
+ *		Main loop only. Events posted from interrupts are queued first.
  *
  ******************************************************************************/
 uint32_t get_scheduled_events(void) {
+	scheduler_drain();
 	return event_scheduled;
 }
+
+/***************************************************************************//**
+ * @brief
+ *		Holds some priorities back until a condition allows them to run.
+ *
+ * @details
+ *		Main loop only. While gate() returns false, events of the gated
+ *		priorities stay queued and are neither dispatched nor counted by
+ *		scheduler_runnable(); higher priorities run as usual. Whatever opens
+ *		the gate should also raise an interrupt, so a sleeping main loop
+ *		wakes to dispatch them.
+ *
+ * @param[in] priorities
+ * 		Bit n set to gate priority n; 0 removes the gate.
+ *
+ * @param[in] gate
+ * 		Returns true while the gated priorities may run.
+ *
+ ******************************************************************************/
+void scheduler_set_gate(uint32_t priorities, Scheduler_Gate_TypeDef gate) {
+	EFM_ASSERT(priorities == 0 || gate);
+	EFM_ASSERT(priorities < (1u << SCHEDULER_NUM_PRIORITIES));
+
+	gated = priorities;
+	gate_open = gate;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns true if an event could be dispatched now.
+ *
+ * @details
+ *		Main loop only. Unlike get_scheduled_events(), events held by the gate
+ *		are not counted, so the main loop may sleep while they wait.
+ *
+ ******************************************************************************/
+bool scheduler_runnable(void) {
+	scheduler_drain();
+	return scheduler_runnable_mask() != 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Runs the handler of the next event.
+ *
+ * @details
+ *		The highest non-empty priority not held by the gate is found with one
+ *		CLZ of the ready mask; within a priority, events run in the order they
+ *		were queued. The handler may post further events. Main loop only.
+ *
+ * @return
+ * 		True if an event was dispatched, false if there was none.
+ *
+ ******************************************************************************/
+bool scheduler_dispatch(void) {
+	Scheduler_Handler_TypeDef handler = NULL;
+	uint32_t payload = 0;
+
+	scheduler_drain();
+	uint32_t runnable = scheduler_runnable_mask();
+
+	if (runnable) {
+		uint32_t priority = 31u - __builtin_clz(runnable);
+		uint32_t slot = queues[priority].head;
+		uint32_t i = queues[priority].event[slot];
+
+		payload = queues[priority].payload[slot];
+		queues[priority].head = (slot + 1) % SCHEDULER_QUEUE_DEPTH;
+		if (--queues[priority].count == 0) {
+			ready &= ~(1u << priority);
+		}
+
+		if (--events[i].queued == 0) {
+			event_scheduled &= ~(1u << i);
+		}
+		if (events[i].coalesce) {
+			payload = events[i].payload;
+		}
+		events[i].stats.dispatched++;
+		handler = events[i].handler;
+	}
+
+	if (handler) {
+		handler(payload);
+	}
+	return handler != NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the posted, dispatched, dropped, coalesced and unhandled counts.
+ *
+ * @details
+ *		Events posted from an interrupt are counted as posted once queued. Those
+ *		dropped because their ring was full appear in the totals only.
+ *
+ * @param[in] event
+ * 		A single event id, or 0 for the totals over all events.
+ *
+ * @param[out] stats
+ * 		The counts.
+ *
+ ******************************************************************************/
+void scheduler_get_stats(uint32_t event, Scheduler_Stats_TypeDef *stats) {
+	if (event) {
+		EFM_ASSERT((event & (event - 1)) == 0);
+		*stats = events[SCHEDULER_INDEX(event)].stats;
+	} else {
+		*stats = (Scheduler_Stats_TypeDef){ 0 };
+		for (uint32_t i = 0; i < SCHEDULER_NUM_EVENTS; i++) {
+			stats->posted += events[i].stats.posted;
+			stats->dispatched += events[i].stats.dispatched;
+			stats->dropped += events[i].stats.dropped;
+			stats->coalesced += events[i].stats.coalesced;
+			stats->unhandled += events[i].stats.unhandled;
+		}
+		for (uint32_t i = 0; i < SCHEDULER_NUM_RINGS; i++) {
+			stats->dropped += rings[i].dropped;
+		}
+	}
+}
@@ -0,0 +1,303 @@
+/**
+ * @file sensors.c
+ * @author Peter Magro
+ * @date August 19th, 2021
+ * @brief Samples the environmental sensors and battery in the background and
+ * 			keeps the latest reading of each.
+ *
+ * @note Each sensor has its own periodic software timer, so sampling runs at
+ * 			its own rate whatever the display is doing. Readings are published into
+ * 			a two-slot cache per sensor: the new sample is written to the slot
+ * 			not being read and then made current, so sensors_get() never waits,
+ * 			even when called from the display interrupts.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "sensors.h"
+
+#include "em_assert.h"
+#include "em_core.h"
+
+#include "battery.h"
+#include "bmp280.h"
+#include "brd_config.h"
+#include "pov.h"
+#include "pt.h"
+#include "rtcc.h"
+#include "si7021.h"
+#include "swtimer.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+/*
+ *	Queues an I2C transfer that completes on SENSORS_I2C_CB, with the sensor's
+ *	id as payload, and waits for it. Afterwards seq->i2c_done is false if the
+ *	transfer could not be queued or was abandoned for taking longer than
+ *	SENSORS_TIMEOUT_MS; the I2C driver's own deadline normally ends it well
+ *	before then. The bus completes a sensor's transfers in the order they were
+ *	queued, each exactly once, so the wait is over when the completions have
+ *	caught up with this transfer's sequence number; a late completion of an
+ *	abandoned transfer only catches up with its own.
+ */
+#define		await_i2c(seq, start)												\
+	do {																		\
+		(seq)->i2c_done = false;												\
+		if (start) {															\
+			(seq)->i2c_queued++;												\
+			(seq)->i2c_started_ms = rtcc_now_ms();								\
+			PT_WAIT_UNTIL(&(seq)->pt, (seq)->i2c_completed == (seq)->i2c_queued || rtcc_now_ms() - (seq)->i2c_started_ms >= SENSORS_TIMEOUT_MS);	\
+			(seq)->i2c_done = (seq)->i2c_completed == (seq)->i2c_queued;		\
+		}																		\
+	} while (0)
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+static Sensors_Sample_TypeDef cache[SENSORS_NUM][2];
+static volatile uint8_t current[SENSORS_NUM];		// Slot of cache[] holding the latest sample
+static SwTimer_TypeDef timers[SENSORS_NUM];
+
+// Each I2C sensor runs its own read sequence. Both share ENVSENSE_I2C_PERIPHERAL,
+// whose queue interleaves their transfers, so neither waits for the other.
+// Locals do not survive an await, so each sequence's state is kept here.
+typedef struct {
+	PT_TypeDef pt;
+	bool pending;									// A sample is waiting to start
+	bool i2c_done;
+	uint8_t i2c_queued;								// Sequence number of the last transfer queued
+	uint8_t i2c_completed;							// and of the last one completed
+	uint32_t i2c_started_ms;
+} Sensors_Sequence_TypeDef;
+
+static Sensors_Sequence_TypeDef sequences[SENSORS_NUM];	// The battery's is unused
+static int32_t pending_humidity;					// Held until the matching temperature read
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Publishes a completed sample.
+ *
+ * @details
+ *		Runs in thread context only. The sample is built in the slot readers
+ *		are not using; switching current[] is a single byte store.
+ *
+ ******************************************************************************/
+static void sensors_publish(Sensors_Id_TypeDef sensor, int32_t first, int32_t second) {
+	const Sensors_Sample_TypeDef *last = &cache[sensor][current[sensor]];
+	uint8_t next = !current[sensor];
+	Sensors_Sample_TypeDef *sample = &cache[sensor][next];
+
+	sample->version = last->version;
+	if (last->seq == 0 || last->values[0] != first || last->values[1] != second) {
+		sample->version++;
+	}
+	sample->values[0] = first;
+	sample->values[1] = second;
+	sample->timestamp_ms = rtcc_now_ms();
+	sample->seq = last->seq + 1;
+
+	current[sensor] = next;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Runs the Si7021 read sequence: humidity, then temperature.
+ *
+ * @details
+ *		A sequence whose transfer was abandoned or failed is dropped without
+ *		publishing, and the next sample starts it again, so a sensor that
+ *		stops answering only costs the bus time of its bounded retries.
+ *
+ ******************************************************************************/
+static char sensors_si7021_thread(Sensors_Sequence_TypeDef *seq) {
+	PT_BEGIN(&seq->pt);
+
+	for (;;) {
+		PT_WAIT_UNTIL(&seq->pt, seq->pending);
+		seq->pending = false;
+
+		await_i2c(seq, si7021_read(SI7021_RELATIVE_HUMIDITY_NO_HOLD, SENSORS_I2C_CB, Sensor_SI7021, 2));
+		if (!seq->i2c_done || si7021_get_status() != I2C_Ok) {
+			continue;
+		}
+		pending_humidity = si7021_calculate_humidity_centi();
+
+		await_i2c(seq, si7021_read(SI7021_TEMPERATURE_NO_HOLD, SENSORS_I2C_CB, Sensor_SI7021, 2));
+		if (!seq->i2c_done || si7021_get_status() != I2C_Ok) {
+			continue;
+		}
+		sensors_publish(Sensor_SI7021, pending_humidity, si7021_calculate_temperature_deci_f());
+	}
+
+	PT_END(&seq->pt);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Runs the BMP280 read sequence: one burst of pressure and temperature.
+ *
+ * @details
+ *		Abandoned sequences are handled as in sensors_si7021_thread().
+ *
+ ******************************************************************************/
+static char sensors_bmp280_thread(Sensors_Sequence_TypeDef *seq) {
+	BMP280_Sample_TypeDef sample;
+
+	PT_BEGIN(&seq->pt);
+
+	for (;;) {
+		PT_WAIT_UNTIL(&seq->pt, seq->pending);
+		seq->pending = false;
+
+		await_i2c(seq, bmp280_read());
+		if (!seq->i2c_done || bmp280_get_status() != I2C_Ok) {
+			continue;
+		}
+		bmp280_get_sample(&sample);
+		sensors_publish(Sensor_BMP280, (int32_t)((sample.pressure_pa + 50) / 100), sample.altitude_dm);
+	}
+
+	PT_END(&seq->pt);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Resumes an I2C sensor's read sequence.
+ *
+ ******************************************************************************/
+static void sensors_run(Sensors_Id_TypeDef sensor) {
+	if (sensor == Sensor_SI7021) {
+		sensors_si7021_thread(&sequences[sensor]);
+	} else if (sensor == Sensor_BMP280) {
+		sensors_bmp280_thread(&sequences[sensor]);
+	} else EFM_ASSERT(false);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Opens the sensors and starts sampling each at its default period.
+ *
+ * @details
+ *		battery_open() and swtimer_open() must be called first. The first sample of each sensor
+ *		is taken one period after this returns; until then sensors_get()
+ *		returns a sample with seq 0.
+ *
+ ******************************************************************************/
+void sensors_open(void) {
+	for (uint32_t sensor = 0; sensor < SENSORS_NUM; sensor++) {
+		cache[sensor][0] = (Sensors_Sample_TypeDef){ 0 };
+		current[sensor] = 0;
+	}
+	for (uint32_t sensor = 0; sensor < SENSORS_NUM; sensor++) {
+		PT_INIT(&sequences[sensor].pt);
+		sequences[sensor].pending = false;
+	}
+	pending_humidity = 0;
+
+	si7021_i2c_open(ENVSENSE_I2C_PERIPHERAL, true, I2C_TICK_CB);
+	bmp280_open(SENSORS_I2C_CB, Sensor_BMP280);
+
+	sensors_set_period(Sensor_SI7021, SENSORS_SI7021_PERIOD_MS);
+	sensors_set_period(Sensor_BMP280, SENSORS_BMP280_PERIOD_MS);
+	sensors_set_period(Sensor_Battery, SENSORS_BATTERY_PERIOD_MS);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Sets how often a sensor is sampled.
+ *
+ * @details
+ *		SENSORS_DUE_CB is posted with the sensor's id as its payload.
+ *
+ * @param[in] sensor
+ * 		The sensor to change.
+ *
+ * @param[in] period_ms
+ * 		The sampling period in milliseconds, or 0 to stop sampling. The last
+ * 		sample stays in the cache.
+ *
+ ******************************************************************************/
+void sensors_set_period(Sensors_Id_TypeDef sensor, uint32_t period_ms) {
+	EFM_ASSERT(sensor < SENSORS_NUM);
+
+	if (period_ms == 0) {
+		swtimer_stop(&timers[sensor]);
+	} else {
+		swtimer_start(&timers[sensor], period_ms, period_ms, SENSORS_DUE_CB, sensor);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Takes a sample of one sensor; called when its period elapses.
+ *
+ * @details
+ *		The battery is read from the ADC's last conversion and published at
+ *		once. I2C sensors start their read sequence and are published when it
+ *		finishes. A sample due while the last is still being read is folded
+ *		into the next one.
+ *
+ ******************************************************************************/
+void sensors_sample(Sensors_Id_TypeDef sensor) {
+	EFM_ASSERT(sensor < SENSORS_NUM);
+
+	if (sensor == Sensor_Battery) {
+		sensors_publish(Sensor_Battery, battery_get_percent_centi(), 0);
+		return;
+	}
+
+	sequences[sensor].pending = true;
+	sensors_run(sensor);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Copies the latest sample of a sensor.
+ *
+ * @details
+ *		Never blocks. Samples are only published from thread context, so a
+ *		reader in an interrupt always sees a complete sample. The slot is
+ *		checked again after the copy in case a publish got in between.
+ *
+ * @param[in] sensor
+ * 		The sensor to read.
+ *
+ * @param[out] out
+ * 		The sample. seq is 0 if the sensor has not been sampled yet.
+ *
+ ******************************************************************************/
+void sensors_get(Sensors_Id_TypeDef sensor, Sensors_Sample_TypeDef *out) {
+	EFM_ASSERT(sensor < SENSORS_NUM);
+	uint8_t slot;
+
+	do {
+		slot = current[sensor];
+		*out = cache[sensor][slot];
+	} while (slot != current[sensor]);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Resumes a sensor's read sequence after an I2C transfer; called on
+ *		SENSORS_I2C_CB.
+ *
+ * @param[in] sensor
+ * 		The sensor the transfer belongs to, from the event payload.
+ *
+ ******************************************************************************/
+void sensors_i2c_done(Sensors_Id_TypeDef sensor) {
+	EFM_ASSERT(sensor < SENSORS_NUM);
+
+	sequences[sensor].i2c_completed++;
+	sensors_run(sensor);
+}
@@ -41,6 +41,7 @@
 
 //** User/developer include files
 #include "sleep_routines.h"
+#include "rtcc.h"
 
 //***********************************************************************************
 // defined files
@@ -50,12 +51,42 @@
 //***********************************************************************************
 // Private variables
 //***********************************************************************************
-static int lowest_energy_mode[MAX_ENERGY_MODES];
+static int32_t lowest_energy_mode[MAX_ENERGY_MODES];		// Changed only by atomic read-modify-write (LDREX/STREX)
+
+// Time spent in each energy mode, in RTCC ticks, since the stats window began.
+// The RTCC stops in EM3, so time asleep there is not counted.
+static uint32_t residency[MAX_ENERGY_MODES];
+static uint32_t wakeups;
+static uint32_t window_start;
+static uint32_t last_wake;
+static bool timing;							// False until the first sleep after sleep_open()
 
 //***********************************************************************************
 // Private functions
 //***********************************************************************************
 
+/***************************************************************************//**
+ * @brief
+ *		Returns the deepest energy mode the blocks allow, or EM0 if the CPU
+ *		cannot sleep.
+ *
+ * @details
+ *		A block on EM1 also keeps the CPU awake, since EM1 is the shallowest
+ *		sleep mode.
+ *
+ ******************************************************************************/
+static uint32_t sleep_deepest_mode(void) {
+	if (lowest_energy_mode[EM0] > 0 || lowest_energy_mode[EM1] > 0) {
+		return EM0;
+	} else if (lowest_energy_mode[EM2] > 0) {
+		return EM1;
+	} else if (lowest_energy_mode[EM3] > 0) {
+		return EM2;
+	} else {
+		return EM3;
+	}
+}
+
 
 //***********************************************************************************
 // Global functions
@@ -78,7 +109,10 @@ void sleep_open(void) {
 
 	for (int i = 0; i < MAX_ENERGY_MODES; i++) {
 		lowest_energy_mode[i] = 0;
+		residency[i] = 0;
 	}
+	wakeups = 0;
+	timing = false;
 
 	CORE_EXIT_CRITICAL();
 }
@@ -91,20 +125,15 @@ void sleep_open(void) {
  *		Increments lowest_energy_mode[EM], and crashes the app if there are more than 4 blocks on energy mode EM.
  *
  * @note
- *		This function is atomic. If this function is called multiple times on a single energy mode, sleep_unblock_mode(EM) must also be called multiple times.
+ *		This function is atomic without masking interrupts, so drivers may call it from their interrupts. If this function is called multiple times on a single energy mode, sleep_unblock_mode(EM) must also be called multiple times.
  *
  * @param[in] EM
  * 		The energy mode to block.
  *
  ******************************************************************************/
 void sleep_block_mode(uint32_t EM) {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
-
-	lowest_energy_mode[EM]++;
-	EFM_ASSERT(lowest_energy_mode[EM] < 5);
-
-	CORE_EXIT_CRITICAL();
+	int32_t blocks = __atomic_add_fetch(&lowest_energy_mode[EM], 1, __ATOMIC_RELAXED);
+	EFM_ASSERT(blocks < 5);
 }
 
 /***************************************************************************//**
@@ -115,20 +144,15 @@ void sleep_block_mode(uint32_t EM) {
  *		Decrements lowest_energy_mode[EM], and crashes the app if there are a negative number of blocks on energy mode EM.
  *
  * @note
- *		This function is atomic.
+ *		This function is atomic without masking interrupts.
  *
  * @param[in] EM
  * 		The energy mode to unblock.
  *
  ******************************************************************************/
 void sleep_unblock_mode(uint32_t EM) {
-	CORE_DECLARE_IRQ_STATE;
-	CORE_ENTER_CRITICAL();
-
-	lowest_energy_mode[EM]--;
-	EFM_ASSERT(lowest_energy_mode[EM] >= 0);
-
-	CORE_EXIT_CRITICAL();
+	int32_t blocks = __atomic_sub_fetch(&lowest_energy_mode[EM], 1, __ATOMIC_RELAXED);
+	EFM_ASSERT(blocks >= 0);
 }
 
 /***************************************************************************//**
@@ -136,39 +160,116 @@ void sleep_unblock_mode(uint32_t EM) {
  *		Enters the lowest allowed energy mode.
  *
  * @details
- *		Steps from high to low energy modes until a block is encountered.
+ *		Steps from high to low energy modes until a block is encountered. The
+ *		time before and during the sleep is added to the EM0 and sleeping
+ *		mode's residency, and the wake-up is counted.
  *
  * @note
  *		This function is atomic. This function will never enter EM4 -- EM3 is the lowest allowed mode.
+ *		Called with interrupts already masked, a pending interrupt still wakes
+ *		the core; see sleep_idle().
  *
  ******************************************************************************/
 void enter_sleep(void) {
 	CORE_DECLARE_IRQ_STATE;
 	CORE_ENTER_CRITICAL();
 
-	if (lowest_energy_mode[EM0] > 0) {
+	uint32_t em = sleep_deepest_mode();
+	if (em == EM0) {
 		CORE_EXIT_CRITICAL();
 		return;
 	}
-	else if (lowest_energy_mode[EM1] > 0) {
-		CORE_EXIT_CRITICAL();
-		return;
+
+	uint32_t asleep = rtcc_now();
+	if (!timing) {
+		window_start = asleep;
+		last_wake = asleep;
+		timing = true;
 	}
-	else if (lowest_energy_mode[EM2] > 0) {
+	residency[EM0] += asleep - last_wake;
+
+	if (em == EM1) {
 		EMU_EnterEM1();
-		CORE_EXIT_CRITICAL();
-		return;
-	}
-	else if (lowest_energy_mode[EM3] > 0) {
+	} else if (em == EM2) {
 		EMU_EnterEM2(true);
-		CORE_EXIT_CRITICAL();
-		return;
-	}
-	else {
+	} else {
 		EMU_EnterEM3(true);
-		CORE_EXIT_CRITICAL();
-		return;
 	}
+
+	last_wake = rtcc_now();
+	residency[em] += last_wake - asleep;
+	wakeups++;
+
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Sleeps until the next interrupt, unless there is work to do.
+ *
+ * @details
+ *		The check and the sleep are made in one critical section. An interrupt
+ *		that fires after the check stays pending instead of running, and a
+ *		pending interrupt ends the sleep at once, so work posted in between is
+ *		never left waiting for the next unrelated wake-up. The interrupt runs
+ *		as soon as this returns.
+ *
+ * @note
+ *		Relies on CORE_ENTER_CRITICAL() masking with PRIMASK; an interrupt
+ *		masked by BASEPRI would not wake the core.
+ *
+ * @param[in] work_pending
+ * 		Returns true if there is work to do; called with interrupts masked.
+ *
+ ******************************************************************************/
+void sleep_idle(bool (*work_pending)(void)) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	if (!work_pending()) {
+		enter_sleep();
+	}
+
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the wake-up rate and energy mode residency.
+ *
+ * @details
+ *		Covers the time since the first sleep after sleep_open(), or since the
+ *		last reset. Time in EM0 is counted up to the most recent wake-up.
+ *
+ * @param[out] stats
+ * 		The wake-ups per second and the share of time spent in each mode.
+ *
+ * @param[in] reset
+ * 		If true, a new window is started after the stats are read.
+ *
+ ******************************************************************************/
+void sleep_get_stats(Sleep_Stats_TypeDef *stats, bool reset) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+
+	uint32_t elapsed = timing ? last_wake - window_start : 0;
+
+	stats->elapsed_ms = (uint32_t)(((uint64_t)elapsed * 1000u) / RTCC_HZ);
+	stats->wakeups = wakeups;
+	stats->wakeups_per_sec = elapsed ? (uint32_t)(((uint64_t)wakeups * RTCC_HZ) / elapsed) : 0;
+	for (int i = 0; i < MAX_ENERGY_MODES; i++) {
+		stats->residency_permille[i] = elapsed ? (uint16_t)(((uint64_t)residency[i] * 1000u) / elapsed) : 0;
+	}
+
+	if (reset && timing) {
+		for (int i = 0; i < MAX_ENERGY_MODES; i++) {
+			residency[i] = 0;
+		}
+		wakeups = 0;
+		window_start = last_wake;
+	}
+
+	CORE_EXIT_CRITICAL();
 }
 
 /***************************************************************************//**
@@ -0,0 +1,183 @@
+/**
+ * @file sprite.c
+ * @author Peter Magro
+ * @date August 14th, 2021
+ * @brief Plays run-length coded, flash-resident animations on the display.
+ *
+ * @note Frames are decoded straight from flash into the framebuffer, and only
+ * 			when the animation moves to a new frame, so a still frame costs
+ * 			nothing per revolution. Every decode is timed with the DWT cycle
+ * 			counter.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "sprite.h"
+
+#include <string.h>
+
+#include "cycles.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+static Sprite_Stats_TypeDef decode_stats;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the animation frame due at the given time.
+ *
+ ******************************************************************************/
+static uint32_t sprite_frame_at(const Sprite_Player_TypeDef *player, uint32_t now_ms) {
+	const Sprite_TypeDef *sprite = player->sprite;
+	return ((now_ms - player->start_ms) / sprite->frame_ms) % sprite->frame_count;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Starts playing an animation, centered on the display.
+ *
+ * @param[in] sprite
+ * 		The animation, normally generated by tools/sprite_convert.py.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds; frame 0 is shown from this point.
+ *
+ ******************************************************************************/
+void sprite_play(Sprite_Player_TypeDef *player, const Sprite_TypeDef *sprite, uint32_t now_ms) {
+	EFM_ASSERT(sprite->width <= DISPLAY_NUM_PIXELS_WIDE);
+	EFM_ASSERT(sprite->frame_count > 0);
+
+	cycles_open();
+
+	player->sprite = sprite;
+	player->start_ms = now_ms;
+	player->frame = 0;
+	player->x = (DISPLAY_NUM_PIXELS_WIDE - sprite->width) / 2;
+	player->decoded = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns true if sprite_update() would decode a frame now.
+ *
+ * @details
+ *		Lets the caller skip preparing a framebuffer for a revolution in which
+ *		the animation has not moved on.
+ *
+ ******************************************************************************/
+bool sprite_due(const Sprite_Player_TypeDef *player, uint32_t now_ms) {
+	return !player->decoded || sprite_frame_at(player, now_ms) != player->frame;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Brings the framebuffer up to date with the animation.
+ *
+ * @details
+ *		Decodes at most one frame. The first call also blanks the columns the
+ *		sprite does not cover; those are never written again while it plays.
+ *
+ * @param[in] frame
+ * 		The framebuffer. Must not be modified by anything else between calls.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds, e.g. from pov_elapsed_ms().
+ *
+ * @return
+ * 		True if a new frame was decoded.
+ *
+ ******************************************************************************/
+bool sprite_update(Sprite_Player_TypeDef *player, POV_Frame_TypeDef *frame, uint32_t now_ms) {
+	const Sprite_TypeDef *sprite = player->sprite;
+	uint32_t index = sprite_frame_at(player, now_ms);
+
+	if (player->decoded && index == player->frame) {
+		return false;
+	}
+
+	if (!player->decoded) {
+		memset(*frame, 0, player->x * sizeof((*frame)[0]));
+		memset((*frame)[player->x + sprite->width], 0,
+				(DISPLAY_NUM_PIXELS_WIDE - player->x - sprite->width) * sizeof((*frame)[0]));
+	}
+
+	uint32_t start = cycles_now();
+	sprite_decode_frame(sprite, index, frame, player->x);
+	uint32_t cost = cycles_now() - start;
+
+	decode_stats.last_cycles = cost;
+	if (cost > decode_stats.max_cycles) {
+		decode_stats.max_cycles = cost;
+	}
+	decode_stats.decodes++;
+
+	player->frame = index;
+	player->decoded = true;
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Decodes one frame of an animation into the framebuffer.
+ *
+ * @details
+ *		Runs are expanded in display order. A malformed frame that would run
+ *		past the sprite's width is clipped rather than overrunning the buffer.
+ *
+ * @param[in] frame_index
+ * 		The frame to decode.
+ *
+ * @param[out] frame
+ * 		The framebuffer to decode into.
+ *
+ * @param[in] x
+ * 		The first display column of the sprite.
+ *
+ ******************************************************************************/
+void sprite_decode_frame(const Sprite_TypeDef *sprite, uint32_t frame_index, POV_Frame_TypeDef *frame, uint32_t x) {
+	EFM_ASSERT(frame_index < sprite->frame_count);
+
+	const uint8_t *in = &sprite->data[sprite->frame_offsets[frame_index]];
+	GRB_TypeDef *out = (*frame)[x];
+	GRB_TypeDef *end = out + sprite->width * WS2812B_NUM_LEDS;
+
+	while (out < end) {
+		uint8_t token = *in++;
+		uint32_t run = (token >> SPRITE_RUN_SHIFT) + 1;
+		GRB_TypeDef color = sprite->palette[token & SPRITE_INDEX_MASK];
+
+		if (run > (uint32_t)(end - out)) {
+			run = end - out;
+		}
+		while (run--) {
+			*out++ = color;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the decode cost statistics, in core clock cycles.
+ *
+ ******************************************************************************/
+void sprite_get_stats(Sprite_Stats_TypeDef *stats) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	*stats = decode_stats;
+	CORE_EXIT_CRITICAL();
+}
@@ -0,0 +1,41 @@
+/**
+ * @file sprite_heart.c
+ * @brief A beating heart, written by hand in the run-length format produced
+ * 			by tools/sprite_convert.py. There is no source image; edit the data
+ * 			directly, keeping heart_frame_offsets in step.
+ *
+ * @note 4 frames, 16 columns, 130 bytes of frame data (2304 uncompressed).
+ */
+
+#include "sprite_data.h"
+
+static const GRB_TypeDef heart_palette[] = {
+	{ 0, 0, 0 },
+	{ 0, 16, 3 },
+	{ 13, 16, 13 },
+};
+
+static const uint8_t heart_data[] = {
+	0xF0, 0xD0, 0x21, 0x70, 0x11, 0x22, 0x50, 0x21, 0x22, 0x40, 0x31, 0x22, 0x40, 0x61, 0x30, 0x71,
+	0x30, 0x71, 0x40, 0x61, 0x40, 0x61, 0x50, 0x51, 0x60, 0x41, 0x70, 0x21, 0xF0, 0xA0, 0xF0, 0x20,
+	0x01, 0x80, 0x41, 0x50, 0x21, 0x22, 0x40, 0x31, 0x32, 0x30, 0x31, 0x32, 0x20, 0x71, 0x20, 0x81,
+	0x20, 0x81, 0x30, 0x71, 0x40, 0x71, 0x30, 0x71, 0x40, 0x51, 0x60, 0x41, 0x80, 0x01, 0xF0, 0xF0,
+	0x00, 0x41, 0x50, 0x21, 0x32, 0x30, 0x31, 0x32, 0x30, 0x31, 0x32, 0x20, 0x41, 0x32, 0x10, 0x91,
+	0x10, 0x91, 0x10, 0x91, 0x10, 0x91, 0x20, 0x81, 0x30, 0x71, 0x30, 0x71, 0x40, 0x61, 0x50, 0x41,
+	0xD0, 0xF0, 0x20, 0x01, 0x80, 0x41, 0x50, 0x21, 0x22, 0x40, 0x31, 0x32, 0x30, 0x31, 0x32, 0x20,
+	0x71, 0x20, 0x81, 0x20, 0x81, 0x30, 0x71, 0x40, 0x71, 0x30, 0x71, 0x40, 0x51, 0x60, 0x41, 0x80,
+	0x01, 0xF0,
+};
+
+static const uint32_t heart_frame_offsets[] = {
+	0, 30, 63, 97,
+};
+
+const Sprite_TypeDef sprite_heart = {
+	.width = 16,
+	.frame_count = 4,
+	.frame_ms = 120,
+	.palette = heart_palette,
+	.data = heart_data,
+	.frame_offsets = heart_frame_offsets,
+};
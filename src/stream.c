@@ -0,0 +1,303 @@
+/**
+ * @file stream.c
+ * @author Peter Magro
+ * @date August 15th, 2021
+ * @brief Streams full-frame animations from the MX25 flash into a ring of
+ * 			framebuffers.
+ *
+ * @note Reads are only made while the LEDs are dark: pov.c opens a prefetch
+ * 			window at the end of each display zone and closes it just before the
+ * 			next one. Frames are fetched in order, ahead of the revolution that
+ * 			shows them, into whichever ring slot is no longer needed.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "stream.h"
+
+#include "em_assert.h"
+#include "em_core.h"
+
+#include "mx25.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define STREAM_NO_FRAME			UINT32_MAX
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+static POV_Frame_TypeDef ring[STREAM_RING_FRAMES] __attribute__((aligned(4)));
+
+// Sequence numbers count frames since stream_open() and never wrap back to an
+// earlier frame, so (seq % frame_count) is the frame in flash and
+// (seq % STREAM_RING_FRAMES) is its ring slot.
+static uint32_t slot_seq[STREAM_RING_FRAMES];
+static bool slot_ready[STREAM_RING_FRAMES];
+
+static Stream_Header_TypeDef header;
+static uint32_t base_address;
+static uint32_t start_ms;
+static bool opened;
+
+static uint32_t shown_seq;				// Frame most recently returned by stream_acquire()
+static uint32_t last_underrun_seq;
+static uint32_t prefetch_ms;			// Time the current prefetch window opened
+
+static uint32_t fetch_seq;
+static uint32_t fetch_pos;				// Bytes of fetch_seq already in its slot
+static volatile bool fetch_active;
+static volatile bool window_open;
+
+static Stream_Stats_TypeDef stats;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+static void stream_fetch_next(void);
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the sequence number due at the given time.
+ *
+ ******************************************************************************/
+static uint32_t stream_due_seq(uint32_t now_ms) {
+	return (now_ms - start_ms) / header.frame_ms;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns true if the frame is fully loaded in its ring slot.
+ *
+ ******************************************************************************/
+static bool stream_is_ready(uint32_t seq) {
+	uint32_t slot = seq % STREAM_RING_FRAMES;
+	return slot_ready[slot] && slot_seq[slot] == seq;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Completion of one chunk read; continues the frame or starts the next.
+ *
+ * @details
+ *		Runs in the DMA interrupt on the target.
+ *
+ ******************************************************************************/
+static void stream_chunk_done(void) {
+	uint32_t chunk = STREAM_FRAME_BYTES - fetch_pos;
+	if (chunk > MX25_MAX_READ_LEN) chunk = MX25_MAX_READ_LEN;
+
+	fetch_active = false;
+	fetch_pos += chunk;
+
+	if (fetch_pos == STREAM_FRAME_BYTES) {
+		slot_ready[fetch_seq % STREAM_RING_FRAMES] = true;
+		stats.frames_loaded++;
+		fetch_pos = 0;
+	}
+
+	if (window_open) {
+		stream_fetch_next();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Starts the next chunk read, if there is a frame worth fetching and a
+ *		free slot for it.
+ *
+ * @details
+ *		A partly read frame is resumed if it is not yet overdue. Otherwise the
+ *		first frame not yet loaded, counting from the one due now, is fetched,
+ *		as long as it is within the ring and does not evict the frame on
+ *		display, which is shown again if the next frame is late.
+ *
+ ******************************************************************************/
+static void stream_fetch_next(void) {
+	uint32_t due = stream_due_seq(prefetch_ms);
+
+	if (fetch_pos == 0 || fetch_seq < due) {
+		uint32_t seq = due;
+		while (stream_is_ready(seq)) {
+			seq++;
+		}
+
+		// Ring full, or the only free slot still holds the frame on display
+		if (seq >= due + STREAM_RING_FRAMES) {
+			return;
+		}
+		if (shown_seq != STREAM_NO_FRAME && seq != shown_seq
+				&& seq % STREAM_RING_FRAMES == shown_seq % STREAM_RING_FRAMES) {
+			return;
+		}
+
+		uint32_t slot = seq % STREAM_RING_FRAMES;
+		slot_seq[slot] = seq;
+		slot_ready[slot] = false;
+		fetch_seq = seq;
+		fetch_pos = 0;
+	}
+
+	uint32_t chunk = STREAM_FRAME_BYTES - fetch_pos;
+	if (chunk > MX25_MAX_READ_LEN) chunk = MX25_MAX_READ_LEN;
+
+	uint32_t address = base_address + header.data_offset
+			+ (fetch_seq % header.frame_count) * header.frame_bytes + fetch_pos;
+
+	fetch_active = true;
+	mx25_read_async(address, (uint8_t *)ring[fetch_seq % STREAM_RING_FRAMES] + fetch_pos, chunk, stream_chunk_done);
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Opens a stream image in the external flash.
+ *
+ * @details
+ *		Reads and checks the header. No frame data is read until the first
+ *		prefetch window.
+ *
+ * @param[in] address
+ * 		The flash address of the image header.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds; frame 0 is due from this point.
+ *
+ * @return
+ * 		True if a valid image was found.
+ *
+ ******************************************************************************/
+bool stream_open(uint32_t address, uint32_t now_ms) {
+	stream_close();
+
+	mx25_read(address, &header, sizeof(header));
+	if (header.magic != STREAM_MAGIC
+			|| header.version != STREAM_VERSION
+			|| header.width != DISPLAY_NUM_PIXELS_WIDE
+			|| header.frame_bytes != STREAM_FRAME_BYTES
+			|| header.frame_count == 0
+			|| header.frame_ms == 0) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < STREAM_RING_FRAMES; i++) {
+		slot_seq[i] = STREAM_NO_FRAME;
+		slot_ready[i] = false;
+	}
+	base_address = address;
+	start_ms = now_ms;
+	shown_seq = STREAM_NO_FRAME;
+	last_underrun_seq = STREAM_NO_FRAME;
+	fetch_seq = 0;
+	fetch_pos = 0;
+	opened = true;
+	return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Stops streaming and cancels any read in progress.
+ *
+ ******************************************************************************/
+void stream_close(void) {
+	stream_end_prefetch();
+	opened = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Opens the prefetch window and starts reading ahead.
+ *
+ * @details
+ *		Reads continue back to back from the DMA interrupt until the ring is
+ *		full or stream_end_prefetch() is called.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds.
+ *
+ ******************************************************************************/
+void stream_prefetch(uint32_t now_ms) {
+	if (!opened) {
+		return;
+	}
+
+	prefetch_ms = now_ms;
+	window_open = true;
+	if (!fetch_active) {
+		stream_fetch_next();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Closes the prefetch window, aborting a read in progress.
+ *
+ * @details
+ *		Must be called before the USART is used for LED data. An aborted frame
+ *		resumes from its last complete chunk in the next window.
+ *
+ ******************************************************************************/
+void stream_end_prefetch(void) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	window_open = false;
+	if (fetch_active) {
+		mx25_abort();
+		fetch_active = false;
+		stats.aborted++;
+	}
+	CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the frame to show now.
+ *
+ * @details
+ *		If the frame due has not been loaded, the previous frame is shown
+ *		again and an underrun is counted once for that frame. The wait for the
+ *		very first frame is not counted.
+ *
+ * @param[in] now_ms
+ * 		The current time in milliseconds.
+ *
+ * @return
+ * 		The frame, or NULL if no frame has been loaded yet.
+ *
+ ******************************************************************************/
+const POV_Frame_TypeDef *stream_acquire(uint32_t now_ms) {
+	if (!opened) {
+		return NULL;
+	}
+
+	uint32_t due = stream_due_seq(now_ms);
+
+	if (stream_is_ready(due)) {
+		shown_seq = due;
+	} else if (shown_seq != STREAM_NO_FRAME && due != shown_seq && due != last_underrun_seq) {
+		stats.underruns++;
+		last_underrun_seq = due;
+	}
+
+	if (shown_seq == STREAM_NO_FRAME) {
+		return NULL;
+	}
+	return &ring[shown_seq % STREAM_RING_FRAMES];
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the loaded, underrun and aborted counts.
+ *
+ ******************************************************************************/
+void stream_get_stats(Stream_Stats_TypeDef *out) {
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	*out = stats;
+	CORE_EXIT_CRITICAL();
+}
@@ -0,0 +1,324 @@
+/**
+ * @file swtimer.c
+ * @author Peter Magro
+ * @date August 20th, 2021
+ * @brief One-shot and periodic software timers on the RTCC, as a hierarchical
+ * 			timer wheel.
+ *
+ * @note The wheel has SWTIMER_LEVELS levels of SWTIMER_SLOTS slots; a slot at
+ * 			level L spans 64^L ticks. A timer is linked into the level whose
+ * 			span covers its remaining time and is moved down a level when the
+ * 			wheel reaches the start of its slot, so start and stop are O(1).
+ * 			The wheel is tickless: the RTCC compare is only set to the next
+ * 			slot with work in it, found from per-level occupancy masks. The
+ * 			RTCC counts in EM2, so the wheel itself needs no HF clock between
+ * 			expiries. The POV measure and tick timers are HF timers, though,
+ * 			and timer_open() blocks EM2 for good, so the device idles in EM1.
+ * 			Expiries are posted to the scheduler as events.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "swtimer.h"
+
+#include <stddef.h>
+
+#include "em_assert.h"
+
+#include "scheduler.h"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define SWTIMER_SHIFT(level)		((level) * SWTIMER_LEVEL_BITS)
+#define SWTIMER_SPAN_MASK(level)	((1u << SWTIMER_SHIFT(level)) - 1u)		// Ticks within one slot
+#define SWTIMER_INDEX(tick, level)	(((tick) >> SWTIMER_SHIFT(level)) & (SWTIMER_SLOTS - 1u))
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+static SwTimer_TypeDef *slots[SWTIMER_LEVELS][SWTIMER_SLOTS];
+static uint64_t occupied[SWTIMER_LEVELS];		// Bit n set while slots[level][n] is not empty
+
+// Wheel time. Every slot at or before it has been handled; every linked timer
+// expires after it, or at it while its slot is being handled.
+static uint32_t now;
+static uint32_t wake_event;
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Links a timer into the slot covering its expiry.
+ *
+ * @details
+ *		The lowest level whose slots reach the expiry within one turn is used,
+ *		so a timer never shares the slot the wheel is currently in at any
+ *		level above 0.
+ *
+ ******************************************************************************/
+static void swtimer_link(SwTimer_TypeDef *timer) {
+	uint32_t delta = timer->expires - now;
+	uint32_t level = 0;
+
+	EFM_ASSERT(delta <= SWTIMER_MAX_TICKS);
+	while (((now & SWTIMER_SPAN_MASK(level)) + delta) >> SWTIMER_SHIFT(level) >= SWTIMER_SLOTS) {
+		level++;
+	}
+
+	uint32_t slot = SWTIMER_INDEX(timer->expires, level);
+	SwTimer_TypeDef **head = &slots[level][slot];
+
+	timer->level = level;
+	timer->slot = slot;
+	timer->next = *head;
+	if (timer->next) {
+		timer->next->prev = &timer->next;
+	}
+	timer->prev = head;
+	*head = timer;
+	occupied[level] |= 1ull << slot;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Removes a running timer from its slot.
+ *
+ ******************************************************************************/
+static void swtimer_unlink(SwTimer_TypeDef *timer) {
+	*timer->prev = timer->next;
+	if (timer->next) {
+		timer->next->prev = timer->prev;
+	}
+	if (!slots[timer->level][timer->slot]) {
+		occupied[timer->level] &= ~(1ull << timer->slot);
+	}
+	timer->prev = NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Detaches and returns the list in a slot.
+ *
+ ******************************************************************************/
+static SwTimer_TypeDef *swtimer_take_slot(uint32_t level, uint32_t slot) {
+	SwTimer_TypeDef *list = slots[level][slot];
+
+	slots[level][slot] = NULL;
+	occupied[level] &= ~(1ull << slot);
+	return list;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Posts a timer's event and re-links it if it is periodic.
+ *
+ * @details
+ *		A periodic timer keeps its phase. If the wheel was woken more than a
+ *		period late, the expiries missed up to the time it is advancing to are
+ *		skipped rather than posted in a burst.
+ *
+ ******************************************************************************/
+static void swtimer_fire(SwTimer_TypeDef *timer, uint32_t to) {
+	timer->prev = NULL;
+	add_scheduled_event_data(timer->event, timer->payload);
+
+	if (timer->period) {
+		timer->expires += timer->period;
+		if ((int32_t)(timer->expires - to) <= 0) {
+			timer->expires += ((to - timer->expires) / timer->period + 1) * timer->period;
+		}
+		swtimer_link(timer);
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns the ticks from the wheel time to the next slot with work in
+ *		it, or 0 if no timer is running.
+ *
+ * @details
+ *		At level 0 that is the next expiry; at higher levels it is the start
+ *		of the next slot to cascade, which is never later than the expiries
+ *		in it. One count-trailing-zeros per level.
+ *
+ ******************************************************************************/
+static uint32_t swtimer_next_delta(void) {
+	uint32_t best = 0;
+
+	for (uint32_t level = 0; level < SWTIMER_LEVELS; level++) {
+		if (!occupied[level]) {
+			continue;
+		}
+
+		// Rotate so that bit 0 is the slot after the current one
+		uint32_t from = (SWTIMER_INDEX(now, level) + 1) & (SWTIMER_SLOTS - 1u);
+		uint64_t ahead = (occupied[level] >> from) | (from ? occupied[level] << (SWTIMER_SLOTS - from) : 0);
+		uint32_t steps = __builtin_ctzll(ahead) + 1;
+		uint32_t delta = (steps << SWTIMER_SHIFT(level)) - (now & SWTIMER_SPAN_MASK(level));
+
+		if (!best || delta < best) {
+			best = delta;
+		}
+	}
+	return best;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Handles every slot the wheel passes on its way to a tick.
+ *
+ * @details
+ *		The wheel jumps straight from one slot with work to the next. At each,
+ *		higher levels are cascaded first, so a timer moved down into the level
+ *		0 slot being handled still fires at its tick.
+ *
+ ******************************************************************************/
+static void swtimer_advance(uint32_t to) {
+	for (;;) {
+		uint32_t delta = swtimer_next_delta();
+		if (!delta || delta > to - now) {
+			now = to;
+			return;
+		}
+		now += delta;
+
+		for (uint32_t level = SWTIMER_LEVELS - 1; level > 0; level--) {
+			if (now & SWTIMER_SPAN_MASK(level)) {
+				continue;
+			}
+			SwTimer_TypeDef *timer = swtimer_take_slot(level, SWTIMER_INDEX(now, level));
+			while (timer) {
+				SwTimer_TypeDef *next = timer->next;
+				swtimer_link(timer);
+				timer = next;
+			}
+		}
+
+		SwTimer_TypeDef *timer = swtimer_take_slot(0, SWTIMER_INDEX(now, 0));
+		while (timer) {
+			SwTimer_TypeDef *next = timer->next;
+			swtimer_fire(timer, to);
+			timer = next;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Sets the RTCC compare to the next slot with work, or stops it.
+ *
+ ******************************************************************************/
+static void swtimer_arm(void) {
+	uint32_t delta = swtimer_next_delta();
+
+	if (delta) {
+		rtcc_compare_start(now + delta, wake_event);
+	} else {
+		rtcc_compare_stop();
+	}
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Opens the RTCC and empties the wheel.
+ *
+ * @param[in] wake_cb
+ * 		The event the RTCC schedules when the wheel has work; its handler must
+ * 		call swtimer_service().
+ *
+ ******************************************************************************/
+void swtimer_open(uint32_t wake_cb) {
+	for (uint32_t level = 0; level < SWTIMER_LEVELS; level++) {
+		for (uint32_t slot = 0; slot < SWTIMER_SLOTS; slot++) {
+			slots[level][slot] = NULL;
+		}
+		occupied[level] = 0;
+	}
+	wake_event = wake_cb;
+
+	rtcc_open();
+	now = rtcc_now();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Starts, or restarts, a timer.
+ *
+ * @param[in] timer
+ * 		The timer; stopped first if it is running.
+ *
+ * @param[in] delay_ms
+ * 		Time until the first expiry, rounded to the nearest RTCC tick and at
+ * 		least one tick.
+ *
+ * @param[in] period_ms
+ * 		Time between later expiries, or 0 for a one-shot timer.
+ *
+ * @param[in] event
+ * 		The event posted to the scheduler on each expiry.
+ *
+ * @param[in] payload
+ * 		The payload posted with the event.
+ *
+ ******************************************************************************/
+void swtimer_start(SwTimer_TypeDef *timer, uint32_t delay_ms, uint32_t period_ms, uint32_t event, uint32_t payload) {
+	uint32_t delay = SWTIMER_MS_TO_TICKS(delay_ms);
+
+	if (swtimer_running(timer)) {
+		swtimer_unlink(timer);
+	}
+
+	// Bring the wheel up to date so that the delay is counted from now
+	swtimer_advance(rtcc_now());
+
+	timer->expires = now + (delay ? delay : 1);
+	timer->period = SWTIMER_MS_TO_TICKS(period_ms);
+	timer->event = event;
+	timer->payload = payload;
+	EFM_ASSERT(period_ms == 0 || timer->period > 0);
+
+	swtimer_link(timer);
+	swtimer_arm();
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Stops a timer. An expiry already posted is not removed.
+ *
+ ******************************************************************************/
+void swtimer_stop(SwTimer_TypeDef *timer) {
+	if (swtimer_running(timer)) {
+		swtimer_unlink(timer);
+		swtimer_arm();
+	}
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Returns true while a timer is waiting to expire.
+ *
+ ******************************************************************************/
+bool swtimer_running(const SwTimer_TypeDef *timer) {
+	return timer->prev != NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Posts every expiry due by now and sets the RTCC for the next one.
+ *
+ * @details
+ *		Called from the handler of the wake event given to swtimer_open().
+ *
+ ******************************************************************************/
+void swtimer_service(void) {
+	swtimer_advance(rtcc_now());
+	swtimer_arm();
+}
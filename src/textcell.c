@@ -0,0 +1,211 @@
+/**
+ * @file textcell.c
+ * @author Peter Magro
+ * @date August 10th, 2021
+ * @brief Fixed-capacity text cells with integer number formatting for the display.
+ *
+ * @note Every write is bounded by TEXTCELL_CAPACITY, so no caller can overrun a
+ * 			display line. Numbers are formatted from fixed-point integers, which keeps
+ * 			newlib's float printf out of the image.
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "textcell.h"
+
+#include <string.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define TEXTCELL_NUMBER_MAX		12u		// '-' + 10 digits + '.'
+
+//***********************************************************************************
+// Static / Private Variables
+//***********************************************************************************
+
+
+//***********************************************************************************
+// Private functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Writes a run of characters into a cell as a padded, aligned field.
+ *
+ * @details
+ *		A width of 0 uses the natural length of the source. If the source is
+ *		longer than a non-zero width, the field is filled with
+ *		TEXTCELL_OVERFLOW_CHAR instead of showing a truncated number. The field is
+ *		always clipped to the space left in the cell.
+ *
+ ******************************************************************************/
+static void textcell_put_field(TextCell_TypeDef *cell, const char *src, uint32_t len, uint32_t width, TextCell_Align_TypeDef align) {
+	uint32_t space = TEXTCELL_CAPACITY - cell->length;
+	uint32_t pad_before = 0;
+	uint32_t pad_after = 0;
+
+	if (width == 0) {
+		width = len;
+	}
+
+	if (len > width) {
+		if (width > space) width = space;
+		memset(&cell->text[cell->length], TEXTCELL_OVERFLOW_CHAR, width);
+		cell->length += width;
+		cell->text[cell->length] = '\0';
+		return;
+	}
+
+	switch (align) {
+	case TextCell_Left:
+		pad_after = width - len;
+		break;
+	case TextCell_Right:
+		pad_before = width - len;
+		break;
+	case TextCell_Center:
+		pad_before = (width - len) / 2;
+		pad_after = width - len - pad_before;
+		break;
+	}
+
+	if (pad_before > space) pad_before = space;
+	memset(&cell->text[cell->length], ' ', pad_before);
+	cell->length += pad_before;
+	space -= pad_before;
+
+	if (len > space) len = space;
+	memcpy(&cell->text[cell->length], src, len);
+	cell->length += len;
+	space -= len;
+
+	if (pad_after > space) pad_after = space;
+	memset(&cell->text[cell->length], ' ', pad_after);
+	cell->length += pad_after;
+
+	cell->text[cell->length] = '\0';
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Formats a fixed-point integer as a decimal string.
+ *
+ * @details
+ *		value is interpreted as value / 10^decimals, so 4523 with two decimals
+ *		is written "45.23". Leading zeros are added as needed ("0.05").
+ *
+ * @return
+ * 		The number of characters written. The output is not NUL terminated.
+ *
+ ******************************************************************************/
+static uint32_t textcell_format_fixed(char out[TEXTCELL_NUMBER_MAX], int32_t value, uint32_t decimals) {
+	char digits[10];
+	uint32_t magnitude = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+	uint32_t count = 0;
+	uint32_t len = 0;
+
+	if (decimals > 9) decimals = 9;
+
+	// Produce digits least significant first, at least one before the point
+	do {
+		digits[count++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while ((magnitude != 0 || count <= decimals) && count < sizeof(digits));
+
+	if (value < 0) {
+		out[len++] = '-';
+	}
+	while (count) {
+		count--;
+		out[len++] = digits[count];
+		if (count == decimals && decimals != 0) {
+			out[len++] = '.';
+		}
+	}
+
+	return len;
+}
+
+//***********************************************************************************
+// Global functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *		Empties a text cell.
+ *
+ ******************************************************************************/
+void textcell_clear(TextCell_TypeDef *cell) {
+	memset(cell->text, '\0', sizeof(cell->text));
+	cell->length = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Appends a string to a text cell.
+ *
+ * @param[in] str
+ * 		The NUL terminated string to append.
+ *
+ * @param[in] width
+ * 		The field width to pad the string to, or 0 for its natural length.
+ *
+ * @param[in] align
+ * 		Where to place the string within the field.
+ *
+ ******************************************************************************/
+void textcell_append_str(TextCell_TypeDef *cell, const char *str, uint32_t width, TextCell_Align_TypeDef align) {
+	textcell_put_field(cell, str, strnlen(str, TEXTCELL_CAPACITY + 1), width, align);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Appends a fixed-point number to a text cell.
+ *
+ * @param[in] value
+ * 		The number, scaled by 10^decimals (e.g. hundredths for decimals = 2).
+ *
+ * @param[in] decimals
+ * 		The number of digits after the decimal point.
+ *
+ * @param[in] width
+ * 		The field width to pad the number to, or 0 for its natural length.
+ *
+ * @param[in] align
+ * 		Where to place the number within the field.
+ *
+ ******************************************************************************/
+void textcell_append_fixed(TextCell_TypeDef *cell, int32_t value, uint32_t decimals, uint32_t width, TextCell_Align_TypeDef align) {
+	char number[TEXTCELL_NUMBER_MAX];
+	uint32_t len = textcell_format_fixed(number, value, decimals);
+	textcell_put_field(cell, number, len, width, align);
+}
+
+/***************************************************************************//**
+ * @brief
+ *		Pads a text cell with spaces to its full capacity.
+ *
+ * @details
+ *		The current contents are moved to the requested side of the cell, or
+ *		centered, and the rest is filled with spaces.
+ *
+ ******************************************************************************/
+void textcell_finish(TextCell_TypeDef *cell, TextCell_Align_TypeDef align) {
+	uint32_t pad = TEXTCELL_CAPACITY - cell->length;
+	uint32_t pad_before = 0;
+
+	if (align == TextCell_Right) {
+		pad_before = pad;
+	} else if (align == TextCell_Center) {
+		pad_before = pad / 2;
+	}
+
+	memmove(&cell->text[pad_before], cell->text, cell->length);
+	memset(cell->text, ' ', pad_before);
+	memset(&cell->text[pad_before + cell->length], ' ', pad - pad_before);
+
+	cell->length = TEXTCELL_CAPACITY;
+	cell->text[TEXTCELL_CAPACITY] = '\0';
+}
@@ -81,12 +81,16 @@ void timer_open(TIMER_TypeDef *timer, TIMER_MEASURE_TypeDef *open_struct) {
 	timer->LOCK = TIMER_LOCK_TIMERLOCKKEY_UNLOCK;			// unlock timer registers
 
 	if (timer == TIMER0) {
+		NVIC_SetPriority(TIMER0_IRQn, open_struct->irq_priority);
 		NVIC_EnableIRQ(TIMER0_IRQn);
 	} else if (timer == TIMER1) {
+		NVIC_SetPriority(TIMER1_IRQn, open_struct->irq_priority);
 		NVIC_EnableIRQ(TIMER1_IRQn);
 	} else if (timer == WTIMER0) {
+		NVIC_SetPriority(WTIMER0_IRQn, open_struct->irq_priority);
 		NVIC_EnableIRQ(WTIMER0_IRQn);
 	} else if (timer == WTIMER1) {
+		NVIC_SetPriority(WTIMER1_IRQn, open_struct->irq_priority);
 		NVIC_EnableIRQ(WTIMER1_IRQn);
 	}
 }
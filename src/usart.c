@@ -13,6 +13,8 @@
 #include "em_assert.h"
 #include "em_cmu.h"
 
+#include "irq.h"
+
 
 //***********************************************************************************
 // defined files
@@ -79,6 +81,7 @@ void usart_bitbang_open(USART_TypeDef *usart, USART_BITBANG_OPEN_TypeDef *usart_
 	usart->CMD = USART_CMD_CLEARTX | USART_CMD_CLEARRX;
 
 	usart->IEN = 0x00;
+	NVIC_SetPriority(USART2_TX_IRQn, IRQ_PRIORITY_BACKGROUND);
 	__NVIC_EnableIRQ(USART2_TX_IRQn);
 
 	USART_Enable(usart, usartEnable);
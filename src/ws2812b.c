@@ -12,9 +12,11 @@
 
 #include <stdlib.h>
 
+#include "em_core.h"
 #include "dmadrv.h"
 
 #include "usart.h"
+#include "irq.h"
 #include "HW_delay.h"
 
 //***********************************************************************************
@@ -26,6 +28,7 @@
 // Static / Private Variables
 //***********************************************************************************
 static uint8_t txbuffer[WS2812B_BUFFER_LEN];
+static volatile bool busy;
 
 //***********************************************************************************
 // Private functions
@@ -56,6 +59,7 @@ void ws2812b_open() {
 		};
 	usart_bitbang_open(WS2812B_USART, &open_struct);
 	DMADRV_Init();
+	NVIC_SetPriority(LDMA_IRQn, IRQ_PRIORITY_BACKGROUND);		// DMADRV_Init() sets EMDRV_DMADRV_DMA_IRQ_PRIORITY (4)
 }
 
 /***************************************************************************//**
@@ -70,12 +74,26 @@ void ws2812b_open() {
  *		PWM signal. Each location in txbuffer[] holds one byte to be sent to the
  *		USART, each representing one bit in the WS2812B protocol.
  *
+ * @note
+ *		A call that interrupts another write is dropped, so the frame being
+ *		sent is never overwritten or sent twice at once. The next write shows
+ *		the dropped data's successor.
+ *
  * @param[in] values
  * 		An array containing GRB data for each LED available.
  *
  ******************************************************************************/
 void ws2812b_write(const GRB_TypeDef values[WS2812B_NUM_LEDS]) {
 
+	CORE_DECLARE_IRQ_STATE;
+	CORE_ENTER_CRITICAL();
+	bool reentered = busy;
+	busy = true;
+	CORE_EXIT_CRITICAL();
+	if (reentered) {
+		return;
+	}
+
 	sleep_block_mode(USART_SLEEP_BLOCK_MODE);
 	timer_delay(1);
 
@@ -113,7 +131,7 @@ void ws2812b_write(const GRB_TypeDef values[WS2812B_NUM_LEDS]) {
 	EFM_ASSERT(DMADRV_AllocateChannel(&channel, NULL) == ECODE_EMDRV_DMADRV_OK);	// allocate a DMA channel and ensure it was successful
 
 	DMADRV_MemoryPeripheral(
-								WS2812B_DMA_CHANNEL,
+								channel,
 								WS2812B_DMA_PERIPHERAL_SIGNAL,
 								(void*)&USART2->TXDATA,
 								txbuffer,
@@ -126,6 +144,7 @@ void ws2812b_write(const GRB_TypeDef values[WS2812B_NUM_LEDS]) {
 
 	timer_delay(1);
 
-	DMADRV_FreeChannel(WS2812B_DMA_CHANNEL);											// free the DMA channel
+	DMADRV_FreeChannel(channel);											// free the DMA channel
 	sleep_unblock_mode(USART_SLEEP_BLOCK_MODE);
+	busy = false;
 }
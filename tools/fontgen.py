@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Generate proportional POV font data from a font source file.
+
+    fontgen.py fonts/large.txt -o src/font_large.c
+
+Source format (see fonts/*.txt):
+
+    name large              C identifier; defines font_<name>
+    height 12               rows per glyph, at most 16
+    spacing 1               blank columns between glyphs
+    fallback ?              glyph drawn for characters the font lacks
+    glyph A                 followed by exactly <height> rows, top row first,
+    ..##..                  '#' = lit, '.' = dark; the row length is the width
+    ...
+    glyph space             'space' names the ' ' glyph
+    kern A V -1             extra columns between a pair, spacing + adjust >= 0
+
+Lines starting with ';' are comments. Glyphs are emitted as one uint16_t per
+column, bit n = row n counted from the bottom (LED n), matching the bottom-up
+LED order of the display.
+"""
+
+import argparse
+import os
+import sys
+
+MAX_HEIGHT = 16
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+NAMED = {'space': ' '}
+
+
+class FontError(Exception):
+    pass
+
+
+def parse(path):
+    font = {'spacing': 1, 'fallback': '?', 'glyphs': {}, 'kerning': []}
+    current = None
+    rows = []
+
+    def finish(line_no):
+        if current is None:
+            return
+        if len(rows) != font['height']:
+            raise FontError('%s:%d: glyph %r has %d rows, expected %d'
+                            % (path, line_no, current, len(rows), font['height']))
+        widths = {len(r) for r in rows}
+        if len(widths) != 1:
+            raise FontError('%s:%d: glyph %r has ragged rows' % (path, line_no, current))
+        font['glyphs'][current] = rows[:]
+
+    with open(path) as f:
+        lines = f.read().split('\n')
+
+    for line_no, raw in enumerate(lines, 1):
+        line = raw.strip()
+        if not line or line.startswith(';'):
+            continue
+        words = line.split()
+        if words[0] in ('name', 'height', 'spacing', 'fallback', 'glyph', 'kern'):
+            if current is not None:
+                finish(line_no)
+                current = None
+                rows = []
+            if words[0] == 'name':
+                font['name'] = words[1]
+            elif words[0] in ('height', 'spacing'):
+                font[words[0]] = int(words[1])
+            elif words[0] == 'fallback':
+                font['fallback'] = NAMED.get(words[1], words[1])
+            elif words[0] == 'glyph':
+                current = NAMED.get(words[1], words[1])
+                if len(current) != 1 or not FIRST_CHAR <= ord(current) <= LAST_CHAR:
+                    raise FontError('%s:%d: bad glyph name %r' % (path, line_no, words[1]))
+                if current in font['glyphs']:
+                    raise FontError('%s:%d: duplicate glyph %r' % (path, line_no, current))
+            else:
+                left, right = (NAMED.get(w, w) for w in words[1:3])
+                font['kerning'].append((left, right, int(words[3]), line_no))
+        elif current is not None and set(line) <= {'#', '.'}:
+            rows.append(line)
+        else:
+            raise FontError('%s:%d: unexpected %r' % (path, line_no, line))
+    finish(len(lines))
+
+    if 'name' not in font or 'height' not in font:
+        raise FontError('%s: name and height are required' % path)
+    if not 1 <= font['height'] <= MAX_HEIGHT:
+        raise FontError('%s: height must be 1 to %d' % (path, MAX_HEIGHT))
+    if font['fallback'] not in font['glyphs']:
+        raise FontError('%s: fallback glyph %r is missing' % (path, font['fallback']))
+    return font
+
+
+def glyph_columns(rows):
+    """Convert top-first rows into bottom-up column bitmasks."""
+    height = len(rows)
+    return [sum(1 << (height - 1 - r) for r in range(height) if rows[r][x] == '#')
+            for x in range(len(rows[0]))]
+
+
+def check_kerning(font, path):
+    """Reject pairs that overlap or leave lit pixels touching side by side."""
+    for left, right, adjust, line_no in font['kerning']:
+        for c in (left, right):
+            if c not in font['glyphs']:
+                raise FontError('%s:%d: kerning uses missing glyph %r' % (path, line_no, c))
+        gap = font['spacing'] + adjust
+        if gap < 0:
+            raise FontError('%s:%d: spacing + adjust must be >= 0' % (path, line_no))
+        a = glyph_columns(font['glyphs'][left])
+        b = glyph_columns(font['glyphs'][right])
+        if gap == 0 and a and b and (a[-1] & (b[0] | (b[0] << 1) | (b[0] >> 1))):
+            raise FontError('%s:%d: kerned pair %r%r touches' % (path, line_no, left, right))
+
+
+def c_char(c):
+    return "'\\%s'" % c if c in '\\\'' else "'%s'" % c
+
+
+def emit_c(font, source):
+    name = font['name']
+    chars = [chr(c) for c in range(FIRST_CHAR, LAST_CHAR + 1)]
+    columns = []
+    offsets = []
+    widths = []
+    comments = []
+    for c in chars:
+        g = font['glyphs'].get(c, font['glyphs'][font['fallback']])
+        cols = glyph_columns(g)
+        offsets.append(len(columns))
+        widths.append(len(cols))
+        comments.append((len(columns), c))
+        columns.extend(cols)
+
+    kerning = sorted((ord(l), ord(r), adj) for l, r, adj, _ in font['kerning'])
+    advance = sum(w + font['spacing'] for w in widths) / len(widths)
+
+    out = []
+    out.append('/**')
+    out.append(' * @file font_%s.c' % name)
+    out.append(' * @brief Generated by tools/fontgen.py from %s. Do not edit.' % source)
+    out.append(' *')
+    out.append(' * @note %d rows, %.2f columns per character on average including spacing.'
+               % (font['height'], advance))
+    out.append(' */')
+    out.append('')
+    out.append('#include "font_data.h"')
+    out.append('')
+    out.append('static const uint8_t %s_widths[FONT_NUM_CHARS] = {' % name)
+    for i in range(0, len(widths), 16):
+        out.append('\t' + ' '.join('%d,' % w for w in widths[i:i + 16]))
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t %s_offsets[FONT_NUM_CHARS] = {' % name)
+    for i in range(0, len(offsets), 12):
+        out.append('\t' + ' '.join('%d,' % o for o in offsets[i:i + 12]))
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t %s_columns[] = {' % name)
+    for (start, c), width in zip(comments, widths):
+        body = ' '.join('0x%04X,' % v for v in columns[start:start + width])
+        out.append("\t%s\t// '%s'" % (body, c))
+    out.append('};')
+    out.append('')
+    if kerning:
+        out.append('static const Font_Kern_TypeDef %s_kerning[] = {' % name)
+        for l, r, adj in kerning:
+            out.append("\t{ %d, %d, %d },\t// %r %r" % (l, r, adj, chr(l), chr(r)))
+        out.append('};')
+        out.append('')
+    out.append('const Font_TypeDef font_%s = {' % name)
+    out.append('\t.height = %d,' % font['height'])
+    out.append('\t.spacing = %d,' % font['spacing'])
+    out.append('\t.fallback = %s,' % c_char(font['fallback']))
+    out.append('\t.widths = %s_widths,' % name)
+    out.append('\t.offsets = %s_offsets,' % name)
+    out.append('\t.columns = %s_columns,' % name)
+    out.append('\t.kerning = %s,' % ('%s_kerning' % name if kerning else 'NULL'))
+    out.append('\t.num_kerning = %d,' % len(kerning))
+    out.append('};')
+    return '\n'.join(out) + '\n', advance
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('source', help='font source file')
+    parser.add_argument('-o', '--output', help='output .c file (default stdout)')
+    args = parser.parse_args()
+
+    try:
+        font = parse(args.source)
+        check_kerning(font, args.source)
+    except FontError as e:
+        sys.exit('fontgen: %s' % e)
+
+    source, advance = emit_c(font, os.path.basename(args.source))
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    print('font_%s: %.2f columns per character, %.1f characters in 96 columns'
+          % (font['name'], advance, 96 / advance), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Pre-render the constant text frames of the POV display.
+
+    framegen.py fonts/small.txt -o src/pov_frames.c
+
+Each frame is two lines of text laid out exactly as pov_render_display() does
+at run time: leading and trailing spaces dropped, clipped to the whole glyphs
+that fit, centered, with the font's spacing and kerning between glyphs. The top
+line's bottom row is LED 6 and the bottom line's is LED 0. Only lit pixels are
+emitted; the rest of the frame is zero.
+"""
+
+import argparse
+import os
+import sys
+
+import fontgen
+
+COLUMNS = 96
+TOP_Y = 6
+
+# name, ((top text, top color), (bottom text, bottom color)); colors are GRB
+FRAMES = [
+    ('credits', (('Keith Graham', (6, 6, 6)), ('Peter Magro', (10, 8, 0)))),
+    ('filler', (('Filler', (6, 6, 6)), ('Filler', (6, 6, 6)))),
+    ('low_battery', (('Low Battery', (0, 63, 0)), ('Recharge Soon', (31, 0, 31)))),
+]
+
+
+def layout(font, text):
+    """Return (x, column bitmask) for every glyph column of a centered line."""
+    glyphs = font['glyphs']
+    kerning = {(l, r): adj for l, r, adj, _ in font['kerning']}
+    line = text.strip(' ')
+
+    def glyph(c):
+        return fontgen.glyph_columns(glyphs.get(c, glyphs[font['fallback']]))
+
+    def gap(a, b):
+        return font['spacing'] + kerning.get((a, b), 0)
+
+    # Clip to the whole glyphs that fit, as fontengine_fit()
+    x = 0
+    count = 0
+    for i, c in enumerate(line):
+        x += len(glyph(c))
+        if x > COLUMNS:
+            break
+        count += 1
+        if i + 1 < len(line):
+            x += gap(c, line[i + 1])
+    line = line[:count]
+
+    width = sum(len(glyph(c)) for c in line)
+    width += sum(gap(a, b) for a, b in zip(line, line[1:]))
+    x = (COLUMNS - width) // 2
+
+    out = []
+    for i, c in enumerate(line):
+        for column in glyph(c):
+            out.append((x, column))
+            x += 1
+        if i + 1 < len(line):
+            x += gap(c, line[i + 1])
+    return line, out
+
+
+def emit_c(font, source):
+    out = []
+    out.append('/**')
+    out.append(' * @file pov_frames.c')
+    out.append(' * @brief Pre-rendered, flash-resident frames for the constant display modes.')
+    out.append(' *')
+    out.append(' * @note Generated by tools/framegen.py from %s. Do not edit.' % source)
+    out.append(' */')
+    out.append('')
+    out.append('//***********************************************************************************')
+    out.append('// Include files')
+    out.append('//***********************************************************************************')
+    out.append('#include "pov_frames.h"')
+    out.append('')
+    out.append('//***********************************************************************************')
+    out.append('// defined files')
+    out.append('//***********************************************************************************')
+    for name, lines in FRAMES:
+        for which, (_, (g, r, b)) in zip(('TOP', 'BOTTOM'), lines):
+            out.append('#define %-27s{ %d, %d, %d }' % ('%s_%s_COLOR' % (name.upper(), which), g, r, b))
+    out.append('')
+    out.append('//***********************************************************************************')
+    out.append('// Global variables')
+    out.append('//***********************************************************************************')
+    for name, lines in FRAMES:
+        columns = {}
+        shown = []
+        for (text, _), which, y in zip(lines, ('TOP', 'BOTTOM'), (TOP_Y, 0)):
+            line, placed = layout(font, text)
+            shown.append(line)
+            color = '%s_%s_COLOR' % (name.upper(), which)
+            for x, bits in placed:
+                for row in range(font['height']):
+                    if (bits >> row) & 1:
+                        columns.setdefault(x, []).append((y + row, color))
+        out.append('')
+        out.append('// "%s" / "%s"' % tuple(shown))
+        out.append('const POV_Frame_TypeDef pov_frame_%s = {' % name)
+        for x in sorted(columns):
+            leds = ', '.join('[%d] = %s' % (led, color) for led, color in sorted(columns[x]))
+            out.append('\t[%d] = { %s },' % (x, leds))
+        out.append('};')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('font', help='font source file, as read by fontgen.py')
+    parser.add_argument('-o', '--output', help='output .c file (default stdout)')
+    args = parser.parse_args()
+
+    try:
+        font = fontgen.parse(args.font)
+    except fontgen.FontError as e:
+        sys.exit('framegen: %s' % e)
+    if TOP_Y + font['height'] > 12:
+        sys.exit('framegen: %s is too tall for two lines' % args.font)
+
+    source = emit_c(font, os.path.basename(args.font))
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+
+
+if __name__ == '__main__':
+    main()
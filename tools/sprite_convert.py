@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Convert PNG/GIF images into run-length coded POV sprites.
+
+Produces a C source file holding a const Sprite_TypeDef (see hdr/sprite.h),
+placed in flash by the compiler.
+
+    sprite_convert.py --name spinner --frame-ms 120 spinner.gif -o src/sprite_spinner.c
+    sprite_convert.py --name logo logo_0.png logo_1.png -o src/sprite_logo.c
+
+Images are WS2812B_NUM_LEDS (12) pixels tall and at most 96 pixels wide; taller
+images are scaled down with --resize. The top image row is shown on the top LED.
+All frames share one palette of at most 16 colors, and images with more colors
+are quantized. Colors are scaled so that white maps to --brightness, because
+the LEDs are driven far below full scale.
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import os
+import sys
+
+NUM_LEDS = 12
+MAX_WIDTH = 96
+MAX_COLORS = 16
+BLACK = (0, 0, 0)
+MAX_RUN = 16
+
+
+def load_frames(paths, resize):
+    """Return (frames, gif_frame_ms); each frame is an RGB PIL image."""
+    from PIL import Image, ImageSequence
+
+    frames = []
+    frame_ms = None
+    for path in paths:
+        image = Image.open(path)
+        for frame in ImageSequence.Iterator(image):
+            if frame_ms is None and 'duration' in frame.info:
+                frame_ms = frame.info['duration']
+            frame = frame.convert('RGB')
+            if resize and frame.height != NUM_LEDS:
+                width = max(1, round(frame.width * NUM_LEDS / frame.height))
+                frame = frame.resize((width, NUM_LEDS), Image.LANCZOS)
+            frames.append(frame)
+    return frames, frame_ms
+
+
+def quantize(frames):
+    """Reduce all frames to one shared palette; return (palette, index frames).
+
+    Index frames are lists of columns, each column NUM_LEDS palette indices
+    from the bottom LED up.
+    """
+    from PIL import Image
+
+    colors = {BLACK}
+    for frame in frames:
+        colors.update(frame.getdata())
+
+    if len(colors) > MAX_COLORS:
+        # Quantize a strip of every frame together so the palette is shared,
+        # leaving palette index 0 for black whether or not the result uses it
+        strip = Image.new('RGB', (sum(f.width for f in frames), NUM_LEDS))
+        x = 0
+        for frame in frames:
+            strip.paste(frame, (x, 0))
+            x += frame.width
+        strip = strip.quantize(MAX_COLORS - 1).convert('RGB')
+        x = 0
+        quantized = []
+        for frame in frames:
+            quantized.append(strip.crop((x, 0, x + frame.width, NUM_LEDS)))
+            x += frame.width
+        frames = quantized
+
+    pixel_frames = []
+    for frame in frames:
+        pixels = frame.load()
+        pixel_frames.append([[pixels[x, NUM_LEDS - 1 - led] for led in range(NUM_LEDS)]
+                             for x in range(frame.width)])
+    return index_frames(pixel_frames)
+
+
+def index_frames(pixel_frames):
+    """Build the palette for frames of (r, g, b) columns; black is always index 0."""
+    palette = [BLACK]
+    lookup = {BLACK: 0}
+    indexed = []
+    for frame in pixel_frames:
+        columns = []
+        for column in frame:
+            out = []
+            for rgb in column:
+                if rgb not in lookup:
+                    lookup[rgb] = len(palette)
+                    palette.append(rgb)
+                out.append(lookup[rgb])
+            columns.append(out)
+        indexed.append(columns)
+    if len(palette) > MAX_COLORS:
+        raise ValueError('%d colors after quantizing, at most %d allowed' % (len(palette), MAX_COLORS))
+    return palette, indexed
+
+
+def encode_frame(columns):
+    """Run-length code one frame in display order, one byte per run."""
+    stream = [index for column in columns for index in column]
+    out = []
+    i = 0
+    while i < len(stream):
+        run = 1
+        while i + run < len(stream) and run < MAX_RUN and stream[i + run] == stream[i]:
+            run += 1
+        out.append(((run - 1) << 4) | stream[i])
+        i += run
+    return out
+
+
+def decode_frame(data, width):
+    """Reference decoder, mirrors sprite_decode_frame()."""
+    stream = []
+    for token in data:
+        stream.extend([token & 0x0F] * ((token >> 4) + 1))
+    stream = stream[:width * NUM_LEDS]
+    return [stream[x * NUM_LEDS:(x + 1) * NUM_LEDS] for x in range(width)]
+
+
+def scale_color(rgb, brightness):
+    return tuple((c * brightness + 127) // 255 for c in rgb)
+
+
+def emit_c(name, palette, frames, frame_ms, brightness, sources):
+    width = len(frames[0])
+    if any(len(frame) != width for frame in frames):
+        raise ValueError('all frames must be the same width')
+    if width > MAX_WIDTH:
+        raise ValueError('sprite is %d columns wide, at most %d allowed' % (width, MAX_WIDTH))
+
+    data = []
+    offsets = []
+    for frame in frames:
+        encoded = encode_frame(frame)
+        assert decode_frame(encoded, width) == frame
+        offsets.append(len(data))
+        data.extend(encoded)
+
+    lines = []
+    lines.append('/**')
+    lines.append(' * @file sprite_%s.c' % name)
+    lines.append(' * @brief Generated by tools/sprite_convert.py from %s. Do not edit.' % ', '.join(sources))
+    lines.append(' *')
+    lines.append(' * @note %d frames, %d columns, %d bytes of frame data (%d uncompressed).'
+                 % (len(frames), width, len(data), len(frames) * width * NUM_LEDS * 3))
+    lines.append(' */')
+    lines.append('')
+    lines.append('#include "sprite_data.h"')
+    lines.append('')
+    lines.append('static const GRB_TypeDef %s_palette[] = {' % name)
+    for rgb in palette:
+        r, g, b = scale_color(rgb, brightness)
+        lines.append('\t{ %d, %d, %d },' % (g, r, b))
+    lines.append('};')
+    lines.append('')
+    lines.append('static const uint8_t %s_data[] = {' % name)
+    for i in range(0, len(data), 16):
+        lines.append('\t' + ' '.join('0x%02X,' % byte for byte in data[i:i + 16]))
+    lines.append('};')
+    lines.append('')
+    lines.append('static const uint32_t %s_frame_offsets[] = {' % name)
+    for i in range(0, len(offsets), 8):
+        lines.append('\t' + ' '.join('%d,' % offset for offset in offsets[i:i + 8]))
+    lines.append('};')
+    lines.append('')
+    lines.append('const Sprite_TypeDef sprite_%s = {' % name)
+    lines.append('\t.width = %d,' % width)
+    lines.append('\t.frame_count = %d,' % len(frames))
+    lines.append('\t.frame_ms = %d,' % frame_ms)
+    lines.append('\t.palette = %s_palette,' % name)
+    lines.append('\t.data = %s_data,' % name)
+    lines.append('\t.frame_offsets = %s_frame_offsets,' % name)
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('images', nargs='+', help='PNG frames in order, or an animated GIF')
+    parser.add_argument('--name', required=True, help='C identifier; defines sprite_<name>')
+    parser.add_argument('--frame-ms', type=int, help='time per frame (default: GIF duration or 100)')
+    parser.add_argument('--brightness', type=int, default=16, help='LED value for full white (default 16)')
+    parser.add_argument('--resize', action='store_true', help='scale images to %d pixels tall' % NUM_LEDS)
+    parser.add_argument('-o', '--output', help='output .c file (default stdout)')
+    args = parser.parse_args()
+
+    frames, gif_frame_ms = load_frames(args.images, args.resize)
+    for frame in frames:
+        if frame.height != NUM_LEDS:
+            parser.error('images must be %d pixels tall (use --resize)' % NUM_LEDS)
+
+    palette, indexed = quantize(frames)
+    frame_ms = args.frame_ms or gif_frame_ms or 100
+    source = emit_c(args.name, palette, indexed, frame_ms, args.brightness,
+                    [os.path.basename(p) for p in args.images])
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    print('declare in hdr/sprite_data.h: extern const Sprite_TypeDef sprite_%s;' % args.name,
+          file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
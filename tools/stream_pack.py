@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Pack PNG/GIF frames into a stream image for the MX25 external flash.
+
+Produces the layout read by src/stream.c: a Stream_Header_TypeDef followed by
+raw POV_Frame_TypeDef frames (96 columns x 12 LEDs x GRB). The same file can be
+used as the flash stand-in for a host build with MX25_HOST_FILE.
+
+    stream_pack.py --frame-ms 50 --resize intro.gif -o intro.bin
+
+Images are 12 pixels tall (use --resize) and 96 pixels wide; narrower images
+are centered. Unlike tools/sprite_convert.py there is no palette limit.
+"""
+
+import argparse
+import struct
+import sys
+
+from sprite_convert import NUM_LEDS, MAX_WIDTH, load_frames, scale_color
+
+STREAM_MAGIC = 0x53564F50
+STREAM_VERSION = 1
+HEADER_FORMAT = '<IHHIIII'
+FRAME_BYTES = MAX_WIDTH * NUM_LEDS * 3
+
+
+def pack_frame(columns, brightness):
+    """columns: list of NUM_LEDS (r, g, b) tuples, bottom LED first."""
+    x0 = (MAX_WIDTH - len(columns)) // 2
+    out = bytearray(FRAME_BYTES)
+    for x, column in enumerate(columns):
+        for led, rgb in enumerate(column):
+            r, g, b = scale_color(rgb, brightness)
+            i = ((x0 + x) * NUM_LEDS + led) * 3
+            out[i:i + 3] = bytes((g, r, b))
+    return bytes(out)
+
+
+def pack(frames, frame_ms, brightness):
+    """frames: list of frames, each a list of columns as for pack_frame()."""
+    header_size = struct.calcsize(HEADER_FORMAT)
+    header = struct.pack(HEADER_FORMAT, STREAM_MAGIC, STREAM_VERSION, MAX_WIDTH,
+                         len(frames), frame_ms, FRAME_BYTES, header_size)
+    return header + b''.join(pack_frame(frame, brightness) for frame in frames)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('images', nargs='+', help='PNG frames in order, or an animated GIF')
+    parser.add_argument('--frame-ms', type=int, help='time per frame (default: GIF duration or 100)')
+    parser.add_argument('--brightness', type=int, default=16, help='LED value for full white (default 16)')
+    parser.add_argument('--resize', action='store_true', help='scale images to %d pixels tall' % NUM_LEDS)
+    parser.add_argument('-o', '--output', required=True, help='output image file')
+    args = parser.parse_args()
+
+    images, gif_frame_ms = load_frames(args.images, args.resize)
+    frames = []
+    for image in images:
+        if image.height != NUM_LEDS or image.width > MAX_WIDTH:
+            parser.error('images must be %d pixels tall and at most %d wide' % (NUM_LEDS, MAX_WIDTH))
+        pixels = image.load()
+        frames.append([[pixels[x, NUM_LEDS - 1 - led] for led in range(NUM_LEDS)]
+                       for x in range(image.width)])
+
+    data = pack(frames, args.frame_ms or gif_frame_ms or 100, args.brightness)
+    with open(args.output, 'wb') as f:
+        f.write(data)
+    print('%d frames, %d bytes' % (len(frames), len(data)), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()